@@ -1,50 +0,0 @@
-/*
-
-    IMPORTANT! This file is auto-generated each time you save your
-    project - if you alter its contents, your changes may be overwritten!
-
-    This is the header file that your files should include in order to get all the
-    JUCE library headers. You should avoid including the JUCE headers directly in
-    your own source files, because that wouldn't pick up the correct configuration
-    options for your app.
-
-*/
-
-#pragma once
-
-
-#include <juce_audio_basics/juce_audio_basics.h>
-#include <juce_audio_devices/juce_audio_devices.h>
-#include <juce_audio_formats/juce_audio_formats.h>
-#include <juce_audio_plugin_client/juce_audio_plugin_client.h>
-#include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_audio_utils/juce_audio_utils.h>
-#include <juce_core/juce_core.h>
-#include <juce_data_structures/juce_data_structures.h>
-#include <juce_dsp/juce_dsp.h>
-#include <juce_events/juce_events.h>
-#include <juce_graphics/juce_graphics.h>
-#include <juce_gui_basics/juce_gui_basics.h>
-#include <juce_gui_extra/juce_gui_extra.h>
-
-#include "BinaryData.h"
-
-#if defined (JUCE_PROJUCER_VERSION) && JUCE_PROJUCER_VERSION < JUCE_VERSION
- /** If you've hit this error then the version of the Projucer that was used to generate this project is
-     older than the version of the JUCE modules being included. To fix this error, re-save your project
-     using the latest version of the Projucer or, if you aren't using the Projucer to manage your project,
-     remove the JUCE_PROJUCER_VERSION define.
- */
- #error "This project was last saved using an outdated version of the Projucer! Re-save this project with the latest version to fix this error."
-#endif
-
-
-#if ! JUCE_DONT_DECLARE_PROJECTINFO
-namespace ProjectInfo
-{
-    const char* const  projectName    = "IRFx";
-    const char* const  companyName    = "Aaron Petrini";
-    const char* const  versionString  = "1.0.7";
-    const int          versionNumber  = 0x10007;
-}
-#endif
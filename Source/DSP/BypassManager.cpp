@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    BypassManager.cpp
+    Created: 19 Oct 2026 8:27:24am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "BypassManager.h"
+
+void BypassFader::prepare(double sampleRate, double rampSeconds)
+{
+    wetGain.reset(sampleRate, rampSeconds);
+}
+
+void BypassFader::setBypassed(bool shouldBeBypassed)
+{
+    const float target = shouldBeBypassed ? 0.f : 1.f;
+
+    if (wetGain.getTargetValue() == target)
+        return;
+
+    // Coming back from full bypass: whatever the module held is stale
+    if (! shouldBeBypassed && isFullyBypassed())
+        resetPending = true;
+
+    wetGain.setTargetValue(target);
+}
+
+void BypassFader::snapTo(bool shouldBeBypassed)
+{
+    if (! shouldBeBypassed && isFullyBypassed())
+        resetPending = true;
+
+    wetGain.setCurrentAndTargetValue(shouldBeBypassed ? 0.f : 1.f);
+}
+
+void BypassFader::crossfade(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& dry, int numSamples)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), dry.getNumChannels());
+    auto* const* wet = buffer.getArrayOfWritePointers();
+    auto* const* in = dry.getArrayOfReadPointers();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float g = wetGain.getNextValue();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            wet[ch][i] = in[ch][i] + (wet[ch][i] - in[ch][i]) * g;
+    }
+}
+
+//==============================================================================
+void BypassManager::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    const int numChannels = juce::jmax(2, static_cast<int>(spec.numChannels));
+    const int numSamples = static_cast<int>(spec.maximumBlockSize);
+
+    moduleDryBuffer.setSize(numChannels, numSamples, false, true, false);
+    pluginDryBuffer.setSize(numChannels, numSamples, false, true, false);
+
+    for (auto& fader : faders)
+        fader.prepare(spec.sampleRate, rampSeconds);
+}
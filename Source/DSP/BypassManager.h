@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    BypassManager.h
+    Created: 19 Oct 2026 8:27:24am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Crossfades one module between its dry input and its processed output.
+ * Once fully bypassed the module is skipped entirely, and when it comes back
+ * a reset is requested so stale filter/delay state is never heard.
+ */
+class BypassFader
+{
+public:
+    void prepare(double sampleRate, double rampSeconds);
+
+    void setBypassed(bool shouldBeBypassed);
+    void snapTo(bool shouldBeBypassed);
+    void skip(int numSamples)       { wetGain.skip(numSamples); }
+
+    bool isFullyBypassed() const    { return ! wetGain.isSmoothing() && wetGain.getTargetValue() == 0.f; }
+    bool isRamping() const          { return wetGain.isSmoothing(); }
+    bool consumeResetRequest()      { return std::exchange(resetPending, false); }
+
+    // buffer holds the processed signal, dry the untouched input.
+    void crossfade(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& dry, int numSamples);
+
+private:
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> wetGain { 1.f };
+    bool resetPending = false;
+};
+
+
+class BypassManager
+{
+public:
+    enum Module
+    {
+        irLoader = 0,
+        toneStack,
+        saturation,
+        delay,
+        plugin,
+        numModules
+    };
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void setBypassed(Module module, bool shouldBeBypassed) { faders[module].setBypassed(shouldBeBypassed); }
+    void snapTo(Module module, bool shouldBeBypassed) { faders[module].snapTo(shouldBeBypassed); }
+    bool isFullyBypassed(Module module) const { return faders[module].isFullyBypassed(); }
+    bool isFullyActive(Module module) const { return ! faders[module].isFullyBypassed() && ! faders[module].isRamping(); }
+
+    /**
+     * Runs processFn (which works on buffer in place) unless the module is fully bypassed.
+     * resetFn is called once when the module comes back from full bypass.
+     * While ramping the dry input is kept aside and crossfaded with the result.
+     */
+    template <typename ResetFn, typename ProcessFn>
+    void process(Module module, juce::AudioBuffer<float>& buffer, ResetFn&& resetFn, ProcessFn&& processFn)
+    {
+        auto& fader = faders[module];
+
+        if (fader.isFullyBypassed())
+            return;
+
+        if (fader.consumeResetRequest())
+            resetFn();
+
+        if (! fader.isRamping())
+        {
+            processFn();
+            return;
+        }
+
+        // The whole-plugin fade wraps the module fades, so it gets its own scratch
+        auto& dry = module == plugin ? pluginDryBuffer : moduleDryBuffer;
+        const int numChannels = juce::jmin(buffer.getNumChannels(), dry.getNumChannels());
+        const int numSamples = buffer.getNumSamples();
+
+        // Host went over the block size it promised: switch hard rather than allocate
+        if (numSamples > dry.getNumSamples())
+        {
+            processFn();
+            fader.skip(numSamples);
+            return;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            dry.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+
+        processFn();
+        fader.crossfade(buffer, dry, numSamples);
+    }
+
+    static constexpr double rampSeconds = 0.02;
+
+private:
+    std::array<BypassFader, numModules> faders;
+    juce::AudioBuffer<float> moduleDryBuffer, pluginDryBuffer;
+};
@@ -20,6 +20,11 @@ void DelayProcessor::prepare(double newSampleRate, int samplesPerBlock, int numC
     const int maxDelaySamples = static_cast<int>(sampleRate * 2.0); // up to 2 sec delay
 //    delayBuffer.setSize(numChannels, maxDelaySamples);
     delayBuffer.setSize(2, maxDelaySamples); // Stereo buffer for ping-pong
+    reset();
+}
+
+void DelayProcessor::reset()
+{
     delayBuffer.clear();
     writePosition = 0;
     prevFilteredL = 0.f;
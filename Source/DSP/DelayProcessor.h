@@ -18,6 +18,7 @@ public:
 
     DelayProcessor();
     void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+    void reset();
     void process(juce::AudioBuffer<float>& buffer, int numSamples, bool isMono);
     
     void setDelayTime(float timeMs);
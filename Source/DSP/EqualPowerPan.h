@@ -18,15 +18,19 @@
  */
 
 
+inline std::pair<float, float> getEqualPowerPanGains(float pan)
+{
+    pan = juce::jlimit(-1.0f, 1.0f, pan);
+    
+    const float angle = (juce::MathConstants<float>::halfPi * 0.5f) * (pan + 1.0f); // 0..π/2
+    return { std::cos(angle), std::sin(angle) };
+}
+
 inline void applyEqualPowerPan(juce::AudioBuffer<float>& buffer, float pan)
 {
     {
         juce::dsp::AudioBlock<float> audioBlock (buffer);
-        pan = juce::jlimit(-1.0f, 1.0f, pan);
-        
-        const float angle     = (juce::MathConstants<float>::halfPi * 0.5f) * (pan + 1.0f); // 0..π/2
-        const float leftGain  = std::cos(angle);
-        const float rightGain = std::sin(angle);
+        const auto [leftGain, rightGain] = getEqualPowerPanGains(pan);
         
         auto left  = audioBlock.getChannelPointer(0);
         auto right = audioBlock.getChannelPointer(1);
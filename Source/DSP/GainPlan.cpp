@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    GainPlan.cpp
+    Created: 19 Oct 2026 8:34:30am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "GainPlan.h"
+#include "EqualPowerPan.h"
+
+GainPlan::BranchGains GainPlan::makeBranchGains(float levelDb, float pan, float makeupDb)
+{
+    const auto [leftGain, rightGain] = getEqualPowerPanGains(pan);
+    const float makeup = juce::Decibels::decibelsToGain(makeupDb);
+    return { juce::Decibels::decibelsToGain(levelDb), leftGain * makeup, rightGain * makeup };
+}
+
+void GainPlan::prepare(const juce::dsp::ProcessSpec& spec, double rampSeconds)
+{
+    inputRamp.reset(spec.sampleRate, rampSeconds);
+    outputRamp.reset(spec.sampleRate, rampSeconds);
+
+    rampGains.assign(juce::jmax<size_t>(1, spec.maximumBlockSize), 0.f);
+    scaledGains.assign(rampGains.size(), 0.f);
+}
+
+void GainPlan::reset()
+{
+    inputRamp.setCurrentAndTargetValue(inputRamp.getTargetValue());
+    outputRamp.setCurrentAndTargetValue(outputRamp.getTargetValue());
+}
+
+void GainPlan::setTargets(float inputGainDb, float outputGainDb)
+{
+    inputRamp.setTargetValue(juce::Decibels::decibelsToGain(inputGainDb));
+    outputRamp.setTargetValue(juce::Decibels::decibelsToGain(outputGainDb));
+}
+
+template <typename Fn>
+void GainPlan::consumeRamp(Ramp& ramp, bool useRamp, int numSamples, Fn&& fn)
+{
+    if (! useRamp)
+    {
+        fn(0, numSamples, nullptr, 1.f);
+        return;
+    }
+
+    if (! ramp.isSmoothing())
+    {
+        fn(0, numSamples, nullptr, ramp.getCurrentValue());
+        return;
+    }
+
+    // Blocks longer than promised are walked in scratch-sized chunks
+    const int chunkSize = static_cast<int>(rampGains.size());
+
+    for (int offset = 0; offset < numSamples; offset += chunkSize)
+    {
+        const int count = juce::jmin(chunkSize, numSamples - offset);
+
+        for (int i = 0; i < count; ++i)
+            rampGains[static_cast<size_t>(i)] = ramp.getNextValue();
+
+        fn(offset, count, rampGains.data(), 1.f);
+    }
+}
+
+void GainPlan::multiplyInto(float* dest, const float* src, const float* ramp, float gain, int numSamples)
+{
+    using FVO = juce::FloatVectorOperations;
+
+    if (ramp == nullptr)
+    {
+        FVO::multiply(dest, src, gain, numSamples);
+        return;
+    }
+
+    FVO::multiply(scaledGains.data(), ramp, gain, numSamples);
+    FVO::multiply(dest, src, scaledGains.data(), numSamples);
+}
+
+void GainPlan::applyInput(juce::AudioBuffer<float>& buffer)
+{
+    consumeRamp(inputRamp, true, buffer.getNumSamples(), [&] (int offset, int count, const float* ramp, float gain)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch, offset);
+            multiplyInto(data, data, ramp, gain, count);
+        }
+    });
+}
+
+void GainPlan::applyInputAndBranch(juce::AudioBuffer<float>& buffer, const BranchGains& gains, bool includeInput)
+{
+    consumeRamp(inputRamp, includeInput, buffer.getNumSamples(), [&] (int offset, int count, const float* ramp, float gain)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch, offset);
+            multiplyInto(data, data, ramp, gain * gains.level, count);
+        }
+    });
+}
+
+void GainPlan::applyInputAndSplit(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& second,
+                                  const BranchGains& firstGains, const BranchGains& secondGains, bool includeInput)
+{
+    jassert(second.getNumChannels() >= buffer.getNumChannels());
+    jassert(second.getNumSamples() >= buffer.getNumSamples());
+
+    consumeRamp(inputRamp, includeInput, buffer.getNumSamples(), [&] (int offset, int count, const float* ramp, float gain)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch, offset);
+
+            // Second branch reads the input before the first branch overwrites it
+            multiplyInto(second.getWritePointer(ch, offset), data, ramp, gain * secondGains.level, count);
+            multiplyInto(data, data, ramp, gain * firstGains.level, count);
+        }
+    });
+}
+
+void GainPlan::applyBranchOutput(juce::AudioBuffer<float>& buffer, const BranchGains& gains)
+{
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch), gains.outputForChannel(ch), buffer.getNumSamples());
+}
+
+void GainPlan::mixBranchOutputs(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& second,
+                                const BranchGains& firstGains, const BranchGains& secondGains)
+{
+    jassert(second.getNumChannels() >= buffer.getNumChannels());
+    jassert(second.getNumSamples() >= buffer.getNumSamples());
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* data = buffer.getWritePointer(ch);
+        juce::FloatVectorOperations::multiply(data, firstGains.outputForChannel(ch), buffer.getNumSamples());
+        juce::FloatVectorOperations::addWithMultiply(data, second.getReadPointer(ch), secondGains.outputForChannel(ch), buffer.getNumSamples());
+    }
+}
+
+void GainPlan::applyOutput(juce::AudioBuffer<float>& buffer)
+{
+    consumeRamp(outputRamp, true, buffer.getNumSamples(), [&] (int offset, int count, const float* ramp, float gain)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch, offset);
+            multiplyInto(data, data, ramp, gain, count);
+        }
+    });
+}
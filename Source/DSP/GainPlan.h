@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    GainPlan.h
+    Created: 19 Oct 2026 8:34:30am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Folds the gains of the chain into as few passes as possible, each on the side of
+ * the convolvers it always was on.
+ *
+ * Input gain and IR level both came before the convolvers, so they share one ramped
+ * multiply there. Pan and the +3/+9 dB makeup stay after them: they step per block,
+ * and a gain that changes over time doesn't commute with convolution (moved in front,
+ * a pan move would fade in across the IR's tail). They are applied in the same pass
+ * that sums the branches. Output gain is the single multiply after the nonlinear stages.
+ *
+ * The input/output ramps behave exactly like the juce::dsp::Gain objects they
+ * replace (linear gain ramp, starting from silence after prepare()).
+ */
+class GainPlan
+{
+public:
+    // Gains of one IR branch for this block: level goes in before the convolver, the pan
+    // law times makeup on L/R after it
+    struct BranchGains
+    {
+        float level { 1.f };
+        float left { 1.f }, right { 1.f };
+
+        float outputForChannel(int ch) const { return ch == 0 ? left : ch == 1 ? right : 1.f; }
+    };
+
+    static BranchGains makeBranchGains(float levelDb, float pan, float makeupDb);
+
+    void prepare(const juce::dsp::ProcessSpec& spec, double rampSeconds);
+    void reset();
+
+    void setTargets(float inputGainDb, float outputGainDb);
+    float getInputGainTarget() const { return inputRamp.getTargetValue(); }
+
+    // Each of these consumes this block's input ramp, so call exactly one per block
+    void applyInput(juce::AudioBuffer<float>& buffer);
+    void applyInputAndBranch(juce::AudioBuffer<float>& buffer, const BranchGains& gains, bool includeInput);
+    void applyInputAndSplit(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& second,
+                            const BranchGains& firstGains, const BranchGains& secondGains, bool includeInput);
+
+    // After the convolvers: one branch's pan and makeup, or both branches' summed into buffer
+    static void applyBranchOutput(juce::AudioBuffer<float>& buffer, const BranchGains& gains);
+    static void mixBranchOutputs(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& second,
+                                 const BranchGains& firstGains, const BranchGains& secondGains);
+
+    void applyOutput(juce::AudioBuffer<float>& buffer);
+
+private:
+    using Ramp = juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear>;
+
+    // Calls fn(offset, count, rampGains, constantGain) over the block.
+    // rampGains is nullptr when the ramp is idle; constantGain is then its value.
+    template <typename Fn>
+    void consumeRamp(Ramp& ramp, bool useRamp, int numSamples, Fn&& fn);
+
+    void multiplyInto(float* dest, const float* src, const float* rampGains, float gain, int numSamples);
+
+    Ramp inputRamp, outputRamp;
+    std::vector<float> rampGains, scaledGains;
+};
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    IRCrossfade.cpp
+    Created: 19 Oct 2026 9:11:51am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRCrossfade.h"
+
+void IRCrossfade::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    scratch.setSize(juce::jmax(2, static_cast<int>(spec.numChannels)), static_cast<int>(spec.maximumBlockSize));
+    reset();
+}
+
+void IRCrossfade::reset()
+{
+    remaining = 0;
+}
+
+void IRCrossfade::start(int numSamples)
+{
+    // Nothing to fade from: the first IR in a slot, or a swap right after prepareToPlay
+    if (replaced == nullptr || replaced->getCurrentIRSize() == 0 || numSamples <= 0)
+    {
+        remaining = 0;
+        return;
+    }
+
+    length = remaining = numSamples;
+}
+
+void IRCrossfade::process(juce::dsp::Convolution& current, juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), scratch.getNumChannels());
+
+    if (! isFading())
+    {
+        juce::dsp::AudioBlock<float> block(buffer);
+        current.process(juce::dsp::ProcessContextReplacing<float>(block));
+        return;
+    }
+
+    jassert(numSamples <= scratch.getNumSamples());
+    for (int ch = 0; ch < numChannels; ++ch)
+        scratch.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+
+    juce::dsp::AudioBlock<float> block(buffer);
+    current.process(juce::dsp::ProcessContextReplacing<float>(block));
+    juce::dsp::AudioBlock<float> replacedBlock(scratch.getArrayOfWritePointers(), static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+    replaced->process(juce::dsp::ProcessContextReplacing<float>(replacedBlock));
+
+    // Linear over the whole fade; the part of the block past its end is the new engine alone
+    const int fadeSamples = juce::jmin(numSamples, remaining);
+    const float startGain = 1.f - static_cast<float>(remaining) / static_cast<float>(length);
+    const float endGain = 1.f - static_cast<float>(remaining - fadeSamples) / static_cast<float>(length);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        buffer.applyGainRamp(ch, 0, fadeSamples, startGain, endGain);
+        buffer.addFromWithRamp(ch, 0, scratch.getReadPointer(ch), fadeSamples, 1.f - startGain, 1.f - endGain);
+    }
+
+    remaining -= fadeSamples;
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    IRCrossfade.h
+    Created: 19 Oct 2026 9:11:51am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Fades one IR slot from the engine it just replaced to the new one, so swapping
+ * convolution engines doesn't click. Both engines run for the length of the fade,
+ * the replaced one on a copy of the input.
+ *
+ * The replaced engine stays in here after the fade; IRHandOver takes it back on the
+ * next swap so it is never freed on the audio thread.
+ */
+class IRCrossfade
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    // Ends any fade at once
+    void reset();
+
+    //========================    AUDIO THREAD    ========================
+    // Right after a swap: fade over numSamples from replaced to the new engine
+    void start(int numSamples);
+    bool isFading() const { return remaining > 0; }
+
+    // Runs current over buffer, mixed with replaced while fading
+    void process(juce::dsp::Convolution& current, juce::AudioBuffer<float>& buffer);
+
+    std::unique_ptr<juce::dsp::Convolution> replaced;
+
+private:
+    juce::AudioBuffer<float> scratch;
+    int length = 0, remaining = 0;
+};
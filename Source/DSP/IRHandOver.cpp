@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    IRHandOver.cpp
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRHandOver.h"
+
+int IRHandOver::beginRequest(int irIndex, bool isRestore)
+{
+    const juce::ScopedLock sl (offerLock);
+    auto& s = slot(irIndex);
+
+    // An engine built for an earlier request (maybe another spec) must not be swapped in any more
+    int expected = ready;
+    if (s.state.compare_exchange_strong(expected, empty))
+        s.engine.reset();
+
+    s.restoring = isRestore;
+    return ++s.generation;
+}
+
+bool IRHandOver::offer(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> engine, int commit)
+{
+    return offerEngine(irIndex, generation, std::move(engine), commit, false);
+}
+
+bool IRHandOver::offerUnload(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> silentEngine, int commit)
+{
+    return offerEngine(irIndex, generation, std::move(silentEngine), commit, true);
+}
+
+bool IRHandOver::offerEngine(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> engine, int commit, bool unloads)
+{
+    const juce::ScopedLock sl (offerLock);
+    auto& s = slot(irIndex);
+
+    if (generation != s.generation.load())
+        return false;
+
+    // Take back an engine the audio thread hasn't picked up yet; if it is swapping right now, let it finish
+    for (;;)
+    {
+        int expected = ready;
+        if (s.state.compare_exchange_strong(expected, empty) || expected == empty)
+            break;
+
+        juce::Thread::yield();
+    }
+
+    // Whatever was in the slot (an unused offer or the engine last swapped out) is freed here
+    s.engine = std::move(engine);
+    s.engineGeneration = generation;
+    s.engineCommit = commit;
+    s.engineUnloads = unloads;
+    if (unloads)
+        s.unloading = true;
+    s.state.store(ready, std::memory_order_release);
+    return true;
+}
+
+void IRHandOver::cancel(int irIndex, int generation)
+{
+    const juce::ScopedLock sl (offerLock);
+    auto& s = slot(irIndex);
+
+    if (generation == s.generation.load())
+        s.restoring = false;
+}
+
+void IRHandOver::reset()
+{
+    const juce::ScopedLock sl (offerLock);
+    for (auto& s : slots)
+    {
+        s.state = empty;
+        s.engine.reset();
+        s.currentUnloads = false;
+        s.unloading = false;
+        s.restoring = false;
+        ++s.generation;
+    }
+}
+
+bool IRHandOver::takeIfReady(int irIndex, int commitsFinished, std::unique_ptr<juce::dsp::Convolution>& current,
+                             std::unique_ptr<juce::dsp::Convolution>& replaced)
+{
+    auto& s = slot(irIndex);
+
+    int expected = ready;
+    if (! s.state.compare_exchange_strong(expected, swapping, std::memory_order_acquire))
+        return false;
+
+    // Its commit is still being written: it swaps in with the rest of the preset
+    if (s.engineCommit > commitsFinished)
+    {
+        s.state.store(ready, std::memory_order_release);
+        return false;
+    }
+
+    // new -> current -> replaced -> slot
+    std::swap(replaced, s.engine);
+    std::swap(current, replaced);
+
+    // The newest request has arrived; an older engine only fills the gap until it does
+    if (s.engineGeneration == s.generation.load())
+        s.restoring = false;
+
+    s.currentUnloads = s.engineUnloads;
+    s.state.store(empty, std::memory_order_release);
+    return true;
+}
+
+void IRHandOver::finishUnload(int irIndex)
+{
+    // Silent by now; a newer unload still waiting has nothing left to fade
+    if (auto& s = slot(irIndex); s.currentUnloads)
+        s.unloading = false;
+}
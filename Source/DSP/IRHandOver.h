@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    IRHandOver.h
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Passes finished convolution engines to the audio thread, one slot per IR.
+ *
+ * Any non-audio thread (message thread, restore jobs) may offer an engine; the audio
+ * thread swaps the newest one in between blocks and keeps the engine it replaces for
+ * a crossfade. The one from the swap before goes back to the slot and is freed by the
+ * next offer, never on the audio thread.
+ *
+ * Every request gets a generation, so when a newer request comes in, results of older
+ * ones still running on a restore thread are dropped instead of installed. A request
+ * may offer more than once (a preview engine, then the full one); the newest wins. A slot is
+ * "restoring" from a restore request until its engine has been swapped in.
+ *
+ * Engines offered while a preset commit is written carry its number and stay put until
+ * the audio thread has seen that commit finish, so the slots of one preset swap together.
+ * Unloading offers a silent engine: the slot fades out to it and counts as "unloading"
+ * until that fade is over, and only the audio thread ever touches the engines in use.
+ *
+ * Shared (std::shared_ptr) with restore jobs, so a job may outlive its processor.
+ */
+class IRHandOver
+{
+public:
+    static constexpr int numSlots = 2;
+
+    //========================    ANY NON-AUDIO THREAD    ========================
+    // Starts a request for irIndex (1 or 2) and returns its generation; older ones go stale
+    int beginRequest(int irIndex, bool isRestore);
+
+    // False, and the engine is dropped, if a newer request for the slot came in meanwhile.
+    // commit: the PresetSwitcher commit being written, or 0 outside of one.
+    bool offer(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> engine, int commit = 0);
+    // As offer, with an engine that outputs silence; the slot is unloading once this succeeds
+    bool offerUnload(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> silentEngine, int commit = 0);
+
+    // Gives up on a restore that can't deliver (nothing to load), so nobody waits for it
+    void cancel(int irIndex, int generation);
+
+    // prepareToPlay only, with the audio thread stopped: the engines are being rebuilt, so
+    // every waiting engine and unfinished unload goes, and older requests go stale
+    void reset();
+
+    //========================    AUDIO THREAD    ========================
+    // Swaps a waiting engine into current and moves the old one to replaced. True if it did.
+    // An engine from a commit later than commitsFinished keeps waiting.
+    bool takeIfReady(int irIndex, int commitsFinished, std::unique_ptr<juce::dsp::Convolution>& current,
+                     std::unique_ptr<juce::dsp::Convolution>& replaced);
+    // Once the fade to an unload's silent engine is over: the slot can drop out
+    void finishUnload(int irIndex);
+
+    //========================    ANY THREAD    ========================
+    bool isRestoring(int irIndex) const { return slot(irIndex).restoring.load(); }
+    // Still fading out to silence: keep running the slot although it is no longer loaded
+    bool isUnloading(int irIndex) const { return slot(irIndex).unloading.load(); }
+    // False once a newer request for the slot came in; lets jobs skip work nobody will take
+    bool isCurrent(int irIndex, int generation) const { return slot(irIndex).generation.load() == generation; }
+
+private:
+    enum State
+    {
+        empty,
+        ready,
+        swapping
+    };
+
+    struct Slot
+    {
+        std::unique_ptr<juce::dsp::Convolution> engine;
+        int engineGeneration = 0;
+        int engineCommit = 0;
+        bool engineUnloads = false;
+        bool currentUnloads = false;    // audio thread only: the engine in use is an unload's
+        std::atomic<int> state { empty };
+        std::atomic<int> generation { 0 };
+        std::atomic<bool> restoring { false };
+        std::atomic<bool> unloading { false };
+    };
+
+    bool offerEngine(int irIndex, int generation, std::unique_ptr<juce::dsp::Convolution> engine, int commit, bool unloads);
+
+    Slot& slot(int irIndex)             { return slots[static_cast<size_t>(irIndex - 1)]; }
+    const Slot& slot(int irIndex) const { return slots[static_cast<size_t>(irIndex - 1)]; }
+
+    std::array<Slot, numSlots> slots;
+    juce::CriticalSection offerLock;    // between offering threads only; the audio thread never takes it
+};
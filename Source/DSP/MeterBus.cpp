@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    MeterBus.cpp
+    Created: 19 Oct 2026 8:36:17am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "MeterBus.h"
+
+namespace
+{
+    // Four independent sums so the compiler can keep them in one vector register
+    float sumOfSquares(const float* data, int numSamples)
+    {
+        float sums[4] {};
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            for (int lane = 0; lane < 4; ++lane)
+                sums[lane] += data[i + lane] * data[i + lane];
+
+        for (; i < numSamples; ++i)
+            sums[0] += data[i] * data[i];
+
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    int countAbove(const float* data, int numSamples, float threshold)
+    {
+        int count = 0;
+        for (int i = 0; i < numSamples; ++i)
+            count += std::abs(data[i]) > threshold ? 1 : 0;
+        return count;
+    }
+}
+
+//==============================================================================
+void MeterBus::setEnabled(bool shouldBeEnabled)
+{
+    // Whatever is still queued from a previous editor is stale
+    if (shouldBeEnabled && ! enabled.load())
+        drain([] (const Frame&) {});
+
+    enabled.store(shouldBeEnabled);
+}
+
+bool MeterBus::beginBlock(int numSamples)
+{
+    activeThisBlock = enabled.load(std::memory_order_relaxed);
+
+    if (! activeThisBlock)
+        return false;
+
+    pending = Frame {};
+    pending.numSamples = numSamples;
+    return true;
+}
+
+void MeterBus::measure(Stage stage, const juce::AudioBuffer<float>& buffer, float gain)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    if (! activeThisBlock || numSamples == 0)
+        return;
+
+    auto& reading = pending.stages[static_cast<size_t>(stage)];
+    const int numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+    const float absGain = std::abs(gain);
+    const float clipThreshold = absGain > 0.f ? 1.f / absGain : std::numeric_limits<float>::max();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* data = buffer.getReadPointer(ch);
+        const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+        const float peak = juce::jmax(-range.getStart(), range.getEnd());
+
+        reading.peak[static_cast<size_t>(ch)] = peak * absGain;
+        reading.rms[static_cast<size_t>(ch)] = std::sqrt(sumOfSquares(data, numSamples) / static_cast<float>(numSamples)) * absGain;
+
+        // Only walk the samples when the vector peak says something is over
+        reading.clipCount[static_cast<size_t>(ch)] = peak > clipThreshold ? countAbove(data, numSamples, clipThreshold) : 0;
+    }
+}
+
+void MeterBus::publish()
+{
+    if (! activeThisBlock)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    // Ring full: the editor is behind, drop this frame rather than block
+    if (size1 > 0)
+        ring[static_cast<size_t>(start1)] = pending;
+
+    fifo.finishedWrite(size1 + size2);
+}
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    MeterBus.h
+    Created: 19 Oct 2026 8:36:17am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Per-stage peak / RMS / clip-count telemetry: input, after the IRs, the tone stack
+ * and the saturation, and output.
+ *
+ * The audio thread measures each stage boundary into a pending frame and
+ * publishes it once per block into a single-producer/single-consumer ring.
+ * The editor drains the ring at its own rate. Nothing is measured unless an
+ * editor has switched the bus on, so headless instances pay nothing.
+ */
+class MeterBus
+{
+public:
+    enum Stage
+    {
+        input = 0,
+        postIR,
+        postEQ,
+        postSaturation,
+        output,
+        numStages
+    };
+
+    static constexpr int maxChannels = 2;
+
+    struct StageReading
+    {
+        std::array<float, maxChannels> peak {}, rms {};
+        std::array<int, maxChannels> clipCount {};
+
+        bool isClipping() const { return clipCount[0] > 0 || clipCount[1] > 0; }
+    };
+
+    struct Frame
+    {
+        std::array<StageReading, numStages> stages {};
+        int numSamples = 0;
+    };
+
+    // Message thread: the editor turns metering on while it is open
+    void setEnabled(bool shouldBeEnabled);
+
+    //========================    AUDIO THREAD    ========================
+    // Returns false (and every measure() is a no-op) while metering is off
+    bool beginBlock(int numSamples);
+
+    // gain is applied to the reading, for stages measured before a gain that is fused further down
+    void measure(Stage stage, const juce::AudioBuffer<float>& buffer, float gain = 1.f);
+    void publish();
+
+    //========================    MESSAGE THREAD    ========================
+    // Calls fn(const Frame&) for every frame published since the last drain, returns how many
+    template <typename Fn>
+    int drain(Fn&& fn)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+            fn(ring[static_cast<size_t>(start1 + i)]);
+        for (int i = 0; i < size2; ++i)
+            fn(ring[static_cast<size_t>(start2 + i)]);
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+private:
+    // A few hundred ms of blocks at 60 Hz polling; frames are dropped if the editor stalls
+    static constexpr int ringSize = 64;
+
+    std::atomic<bool> enabled { false };
+    bool activeThisBlock = false;
+
+    Frame pending;
+
+    juce::AbstractFifo fifo { ringSize };
+    std::array<Frame, ringSize> ring {};
+};
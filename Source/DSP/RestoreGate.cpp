@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    RestoreGate.cpp
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "RestoreGate.h"
+
+void RestoreGate::prepare(const juce::dsp::ProcessSpec& spec, double fadeSeconds)
+{
+    fader.prepare(spec.sampleRate, fadeSeconds);
+    held.setSize(juce::jmax(2, static_cast<int>(spec.numChannels)), static_cast<int>(spec.maximumBlockSize));
+    reset();
+}
+
+void RestoreGate::reset()
+{
+    // A reset lands wherever the gate is heading; no half-finished fade afterwards
+    fader.snapTo(wasWaiting);
+    fader.consumeResetRequest();
+    active = wasWaiting;
+}
+
+void RestoreGate::begin(const juce::AudioBuffer<float>& buffer, bool isWaiting)
+{
+    if (isWaiting && ! wasWaiting)
+        fader.snapTo(true);
+    else
+        fader.setBypassed(isWaiting);
+
+    wasWaiting = isWaiting;
+    active = fader.isFullyBypassed() || fader.isRamping();
+
+    if (! active)
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), held.getNumChannels());
+    jassert(numSamples <= held.getNumSamples());
+
+    if (mode.load() == Mode::silence)
+        held.clear(0, numSamples);
+    else
+        for (int ch = 0; ch < numChannels; ++ch)
+            held.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+}
+
+void RestoreGate::end(juce::AudioBuffer<float>& buffer)
+{
+    if (! active)
+        return;
+
+    fader.consumeResetRequest();
+    fader.crossfade(buffer, held, buffer.getNumSamples());
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    RestoreGate.h
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "BypassManager.h"
+
+/**
+ * Holds the plugin's output back while its IRs are still being restored after a
+ * session load: the dry input or silence goes out instead, and once every IR in
+ * use is in, the processed signal fades in.
+ *
+ * Closes at once when a restore starts and opens over fadeSeconds. Costs a copy per
+ * block only while closed or fading.
+ */
+class RestoreGate
+{
+public:
+    enum class Mode
+    {
+        dry = 0,
+        silence
+    };
+
+    void prepare(const juce::dsp::ProcessSpec& spec, double fadeSeconds);
+    void reset();
+
+    // Any thread
+    void setMode(Mode newMode)  { mode.store(newMode); }
+    Mode getMode() const        { return mode.load(); }
+
+    //========================    AUDIO THREAD    ========================
+    // Before processing: whether an IR in use is still on its way. Keeps the input aside if needed.
+    void begin(const juce::AudioBuffer<float>& buffer, bool isWaiting);
+    // After processing: replaces or fades the output
+    void end(juce::AudioBuffer<float>& buffer);
+
+    bool isOpen() const { return ! active; }
+
+private:
+    BypassFader fader;      // "bypassed" = held back
+    juce::AudioBuffer<float> held;
+    std::atomic<Mode> mode { Mode::dry };
+    bool active = false, wasWaiting = false;
+};
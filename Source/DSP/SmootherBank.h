@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    SmootherBank.h
+    Created: 19 Oct 2026 8:30:13am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <bit>
+
+/**
+ * N linear smoothers kept as parallel arrays instead of N SmoothedValue objects.
+ * Behaves like juce::SmoothedValue<float, Linear> for each slot.
+ *
+ * skip() advances every slot with a handful of vector ops, and the bank keeps
+ * two bitmasks (bit i = slot i) so callers only redo work for what moved:
+ *  - rampingMask: slots still heading towards their target
+ *  - movedMask:   slots whose current value changed in the last skip(), or
+ *                 were set directly just before it
+ */
+template <size_t N>
+class SmootherBank
+{
+public:
+    static_assert(N > 0 && N <= 64, "SmootherBank masks are 64 bits wide");
+    using Mask = uint64_t;
+    static constexpr Mask bit(size_t i) { return Mask { 1 } << i; }
+    static constexpr Mask allSlots = N == 64 ? ~Mask { 0 } : (Mask { 1 } << N) - 1;
+
+    void reset(double sampleRate, const std::array<float, N>& rampSeconds)
+    {
+        for (size_t i = 0; i < N; ++i)
+            stepsToTarget[i] = static_cast<int>(std::floor(rampSeconds[i] * sampleRate));
+
+        current = target;
+        std::fill(countdown.begin(), countdown.end(), 0.f);
+        std::fill(step.begin(), step.end(), 0.f);
+        rampingMask = 0;
+        jumpedMask = allSlots;
+    }
+
+    void setCurrentAndTargetValue(size_t i, float newValue)
+    {
+        if (! juce::exactlyEqual(current[i], newValue))
+            jumpedMask |= bit(i);
+
+        current[i] = target[i] = newValue;
+        countdown[i] = 0.f;
+        step[i] = 0.f;
+        rampingMask &= ~bit(i);
+    }
+
+    void setTargetValue(size_t i, float newValue)
+    {
+        setTargetValue(i, newValue, stepsToTarget[i]);
+    }
+
+    // Same, but this one ramp takes numSteps samples instead of the slot's own ramp length
+    void setTargetValue(size_t i, float newValue, int numSteps)
+    {
+        if (juce::approximatelyEqual(newValue, target[i]))
+            return;
+
+        if (numSteps <= 0)
+        {
+            setCurrentAndTargetValue(i, newValue);
+            return;
+        }
+
+        target[i] = newValue;
+        countdown[i] = static_cast<float>(numSteps);
+        step[i] = (target[i] - current[i]) / countdown[i];
+        rampingMask |= bit(i);
+    }
+
+    void skip(int numSamples)
+    {
+        // Everything that was ramping will have moved by the end of this call
+        movedMask = jumpedMask | rampingMask;
+        jumpedMask = 0;
+
+        // Idle bank: nothing to do at all
+        if (rampingMask == 0)
+            return;
+
+        // Idle slots have step == 0 and countdown == 0, so they ride along unchanged
+        using FVO = juce::FloatVectorOperations;
+        FVO::min(advance.data(), countdown.data(), static_cast<float>(numSamples), numSlots);
+        FVO::addWithMultiply(current.data(), step.data(), advance.data(), numSlots);
+        FVO::subtract(countdown.data(), advance.data(), numSlots);
+
+        // Land exactly on target for the slots that just finished
+        for (auto remaining = rampingMask; remaining != 0; remaining &= remaining - 1)
+        {
+            const auto i = static_cast<size_t>(std::countr_zero(remaining));
+            if (countdown[i] <= 0.f)
+            {
+                current[i] = target[i];
+                countdown[i] = 0.f;
+                step[i] = 0.f;
+                rampingMask &= ~bit(i);
+            }
+        }
+    }
+
+    float getCurrentValue(size_t i) const   { return current[i]; }
+    float getTargetValue(size_t i) const    { return target[i]; }
+    bool isSmoothing(size_t i) const        { return (rampingMask & bit(i)) != 0; }
+
+    Mask getRampingMask() const             { return rampingMask; }
+    Mask getMovedMask() const               { return movedMask; }
+    bool anyMoved(Mask slots) const         { return (movedMask & slots) != 0; }
+
+private:
+    static constexpr int numSlots = static_cast<int>(N);
+
+    alignas(16) std::array<float, N> current {}, target {}, step {}, countdown {}, advance {};
+    std::array<int, N> stepsToTarget {};
+    Mask rampingMask = 0, movedMask = allSlots, jumpedMask = allSlots;
+};
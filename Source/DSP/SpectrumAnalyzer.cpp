@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 19 Oct 2026 8:38:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+namespace
+{
+    // Per-FFT-frame smoothing in dB: rise quickly, fall slowly
+    constexpr float attack = 0.7f;
+    constexpr float release = 0.2f;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer() : juce::Thread("IRFx Spectrum")
+{
+    for (auto& tap : taps)
+    {
+        tap.fifoBuffer.assign(static_cast<size_t>(tap.fifo.getTotalSize()), 0.f);
+        tap.frame.assign(fftSize, 0.f);
+        tap.fftData.assign(2 * fftSize, 0.f);
+    }
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stop();
+}
+
+void SpectrumAnalyzer::push(Tap tap, const juce::AudioBuffer<float>& buffer, float gain)
+{
+    if (! active.load(std::memory_order_relaxed))
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    auto& state = taps[static_cast<size_t>(tap)];
+    const float scale = gain / static_cast<float>(numChannels);
+
+    // Whatever doesn't fit is dropped; the background thread will catch up
+    int start1, size1, start2, size2;
+    state.fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    auto mixInto = [&] (int fifoStart, int count, int bufferOffset)
+    {
+        if (count <= 0)
+            return;
+
+        auto* dest = state.fifoBuffer.data() + fifoStart;
+        juce::FloatVectorOperations::copyWithMultiply(dest, buffer.getReadPointer(0, bufferOffset), scale, count);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply(dest, buffer.getReadPointer(ch, bufferOffset), scale, count);
+    };
+
+    mixInto(start1, size1, 0);
+    mixInto(start2, size2, size1);
+    state.fifo.finishedWrite(size1 + size2);
+}
+
+void SpectrumAnalyzer::start()
+{
+    if (isThreadRunning())
+        return;
+
+    // The thread is parked, so this side can act as the consumer and flush stale audio
+    for (auto& tap : taps)
+    {
+        tap.fifo.finishedRead(tap.fifo.getNumReady());
+        std::fill(tap.frame.begin(), tap.frame.end(), 0.f);
+        tap.smoothedDecibels.fill(minDecibels);
+    }
+
+    active.store(true);
+    startThread(juce::Thread::Priority::low);
+}
+
+void SpectrumAnalyzer::stop()
+{
+    active.store(false);
+    stopThread(1000);
+}
+
+void SpectrumAnalyzer::copyPath(Tap tap, juce::Path& dest) const
+{
+    const auto& state = taps[static_cast<size_t>(tap)];
+    const juce::SpinLock::ScopedLockType lock(state.pathLock);
+    dest = state.front;
+}
+
+float SpectrumAnalyzer::frequencyToX(float frequency)
+{
+    return std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        if (const double rate = sampleRate.load(); rate != mappedSampleRate)
+            updatePointMapping(rate);
+
+        for (auto& tap : taps)
+            if (processTap(tap))
+                publishPath(tap);
+
+        // A hop is ~10 ms at 48 kHz, so polling at that rate keeps up without spinning
+        wait(10);
+    }
+}
+
+bool SpectrumAnalyzer::processTap(TapState& tap)
+{
+    bool analysed = false;
+
+    while (tap.fifo.getNumReady() >= hopSize)
+    {
+        std::memmove(tap.frame.data(), tap.frame.data() + hopSize, sizeof(float) * (fftSize - hopSize));
+
+        int start1, size1, start2, size2;
+        tap.fifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+        auto* newest = tap.frame.data() + (fftSize - hopSize);
+        std::copy_n(tap.fifoBuffer.data() + start1, size1, newest);
+        std::copy_n(tap.fifoBuffer.data() + start2, size2, newest + size1);
+        tap.fifo.finishedRead(size1 + size2);
+
+        analyseFrame(tap);
+        analysed = true;
+    }
+
+    return analysed;
+}
+
+void SpectrumAnalyzer::analyseFrame(TapState& tap)
+{
+    std::copy(tap.frame.begin(), tap.frame.end(), tap.fftData.begin());
+    std::fill(tap.fftData.begin() + fftSize, tap.fftData.end(), 0.f);
+
+    window.multiplyWithWindowingTable(tap.fftData.data(), fftSize);
+    fft.performFrequencyOnlyForwardTransform(tap.fftData.data(), true);
+
+    // The window is normalised, so a full-scale sine lands at fftSize / 2
+    constexpr float magnitudeScale = 2.f / fftSize;
+    constexpr int lastBin = fftSize / 2 - 1;
+
+    for (size_t p = 0; p < numPoints; ++p)
+    {
+        const float lowBin = pointLowBin[p];
+        const float highBin = pointHighBin[p];
+        float magnitude = 0.f;
+
+        if (highBin - lowBin < 1.f)
+        {
+            // Low end: several points share a bin, so interpolate between bins
+            const float centre = juce::jlimit(0.f, static_cast<float>(lastBin), 0.5f * (lowBin + highBin));
+            const int index = juce::jmin(static_cast<int>(centre), lastBin - 1);
+            const float fraction = centre - static_cast<float>(index);
+            magnitude = tap.fftData[static_cast<size_t>(index)] + (tap.fftData[static_cast<size_t>(index + 1)] - tap.fftData[static_cast<size_t>(index)]) * fraction;
+        }
+        else
+        {
+            // High end: each point covers many bins, keep the loudest
+            const int first = juce::jlimit(0, lastBin, static_cast<int>(std::ceil(lowBin)));
+            const int last = juce::jlimit(first, lastBin, static_cast<int>(std::floor(highBin)));
+            for (int bin = first; bin <= last; ++bin)
+                magnitude = juce::jmax(magnitude, tap.fftData[static_cast<size_t>(bin)]);
+        }
+
+        const float decibels = juce::jlimit(minDecibels, maxDecibels, juce::Decibels::gainToDecibels(magnitude * magnitudeScale, minDecibels));
+        auto& smoothed = tap.smoothedDecibels[p];
+        smoothed += (decibels - smoothed) * (decibels > smoothed ? attack : release);
+    }
+}
+
+void SpectrumAnalyzer::publishPath(TapState& tap)
+{
+    tap.back.clear();
+
+    for (size_t p = 0; p < numPoints; ++p)
+    {
+        const float x = static_cast<float>(p) / (numPoints - 1);
+        const float y = juce::jmap(tap.smoothedDecibels[p], minDecibels, maxDecibels, 1.f, 0.f);
+
+        if (p == 0)
+            tap.back.startNewSubPath(x, y);
+        else
+            tap.back.lineTo(x, y);
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(tap.pathLock);
+        tap.front.swapWithPath(tap.back);
+    }
+
+    tap.version.fetch_add(1);
+}
+
+void SpectrumAnalyzer::updatePointMapping(double rate)
+{
+    const float range = maxFrequency / minFrequency;
+    const float halfStep = std::pow(range, 0.5f / (numPoints - 1));
+    const float binsPerHz = static_cast<float>(fftSize / rate);
+
+    for (size_t p = 0; p < numPoints; ++p)
+    {
+        const float frequency = minFrequency * std::pow(range, static_cast<float>(p) / (numPoints - 1));
+        pointLowBin[p] = frequency / halfStep * binsPerHz;
+        pointHighBin[p] = frequency * halfStep * binsPerHz;
+    }
+
+    mappedSampleRate = rate;
+}
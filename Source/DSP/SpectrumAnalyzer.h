@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 19 Oct 2026 8:38:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Pre/post spectrum analysis that never blocks the audio thread.
+ *
+ * The audio thread only downmixes into a wait-free FIFO per tap. A background
+ * thread runs Hann-windowed FFTs with 75% overlap, maps them onto log-spaced
+ * display points with attack/release smoothing, and swaps the result into a
+ * double-buffered path the editor copies out at its own frame rate.
+ *
+ * Nothing runs until start() is called, and stop() parks everything again.
+ */
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    enum Tap
+    {
+        pre = 0,
+        post,
+        numTaps
+    };
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numPoints = 256;
+
+    static constexpr float minFrequency = 20.f;
+    static constexpr float maxFrequency = 20000.f;
+    static constexpr float minDecibels = -90.f;
+    static constexpr float maxDecibels = 6.f;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    void prepare(double newSampleRate) { sampleRate.store(newSampleRate); }
+
+    // Audio thread: mono mix of buffer (times gain) into the tap's FIFO; a no-op while stopped
+    void push(Tap tap, const juce::AudioBuffer<float>& buffer, float gain = 1.f);
+
+    //========================    MESSAGE THREAD    ========================
+    void start();
+    void stop();
+
+    // Bumped every time a new path is ready for this tap
+    uint32_t getPathVersion(Tap tap) const { return taps[static_cast<size_t>(tap)].version.load(); }
+
+    // Latest curve in normalised coordinates: x = 0..1 over log frequency, y = 0 (maxDecibels) .. 1 (minDecibels)
+    void copyPath(Tap tap, juce::Path& dest) const;
+
+    // Normalised x position of a frequency, for drawing a matching grid
+    static float frequencyToX(float frequency);
+
+private:
+    void run() override;
+
+    struct TapState
+    {
+        juce::AbstractFifo fifo { fftSize * 4 };
+        std::vector<float> fifoBuffer;
+
+        std::vector<float> frame;       // last fftSize samples, oldest first
+        std::vector<float> fftData;     // 2 * fftSize for the real-only transform
+        std::array<float, numPoints> smoothedDecibels {};
+
+        juce::Path back, front;
+        mutable juce::SpinLock pathLock;
+        std::atomic<uint32_t> version { 0 };
+    };
+
+    bool processTap(TapState& tap);
+    void analyseFrame(TapState& tap);
+    void publishPath(TapState& tap);
+    void updatePointMapping(double rate);
+
+    std::array<TapState, numTaps> taps;
+
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, true };
+
+    // Fractional FFT bin range covered by each display point
+    std::array<float, numPoints> pointLowBin {}, pointHighBin {};
+    double mappedSampleRate = 0.0;
+
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<bool> active { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
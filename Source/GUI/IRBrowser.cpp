@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    IRBrowser.cpp
+    Created: 19 Oct 2026 9:19:38am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRBrowser.h"
+
+namespace
+{
+    const juce::Colour darkPink = juce::Colour::fromRGB(200, 30, 100);
+}
+
+//==============================================================================
+IRBrowser::IRBrowser()
+{
+    searchBox.setTextToShowWhenEmpty("Search IRs", juce::Colours::grey);
+    searchBox.onTextChange = [this] { refresh(); };
+    searchBox.onReturnKey = [this] { list.selectRow(0); };
+    searchBox.onEscapeKey = [this] { close(); };
+    addAndMakeVisible(searchBox);
+
+    sortBox.addItemList({ "By name", "By length", "By brightness" }, 1);
+    sortBox.setSelectedId(1, juce::dontSendNotification);
+    sortBox.onChange = [this] { refresh(); };
+    addAndMakeVisible(sortBox);
+
+    channelsBox.addItemList({ "Any", "Mono", "Stereo" }, 1);
+    channelsBox.setSelectedId(1, juce::dontSendNotification);
+    channelsBox.onChange = [this] { refresh(); };
+    addAndMakeVisible(channelsBox);
+
+    list.setRowHeight(30);
+    list.setColour(juce::ListBox::backgroundColourId, juce::Colours::transparentBlack);
+    addAndMakeVisible(list);
+
+    addFolderButton.onClick = [this] { chooseFolder(); };
+    addAndMakeVisible(addFolderButton);
+
+    otherFileButton.onClick = [this]
+    {
+        close();
+        if (onBrowseFile)
+            onBrowseFile();
+    };
+    addAndMakeVisible(otherFileButton);
+
+    closeButton.onClick = [this] { close(); };
+    addAndMakeVisible(closeButton);
+
+    statusLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    addAndMakeVisible(statusLabel);
+
+    library->addChangeListener(this);
+}
+
+IRBrowser::~IRBrowser()
+{
+    library->removeChangeListener(this);
+}
+
+void IRBrowser::show(const juce::File& currentFile)
+{
+    current = currentFile;
+    refresh();
+    setVisible(true);
+    toFront(false);
+    searchBox.grabKeyboardFocus();
+}
+
+void IRBrowser::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.9f));
+}
+
+void IRBrowser::resized()
+{
+    auto area = getLocalBounds().reduced(8);
+
+    auto top = area.removeFromTop(24);
+    channelsBox.setBounds(top.removeFromRight(80));
+    top.removeFromRight(4);
+    sortBox.setBounds(top.removeFromRight(110));
+    top.removeFromRight(4);
+    searchBox.setBounds(top);
+
+    auto bottom = area.removeFromBottom(24);
+    closeButton.setBounds(bottom.removeFromRight(60));
+    bottom.removeFromRight(4);
+    otherFileButton.setBounds(bottom.removeFromRight(90));
+    bottom.removeFromRight(4);
+    addFolderButton.setBounds(bottom.removeFromRight(90));
+    statusLabel.setBounds(bottom);
+
+    area.removeFromTop(4);
+    area.removeFromBottom(4);
+    list.setBounds(area);
+}
+
+bool IRBrowser::keyPressed (const juce::KeyPress& key)
+{
+    if (key == juce::KeyPress::escapeKey)
+    {
+        close();
+        return true;
+    }
+    return false;
+}
+
+void IRBrowser::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    // The library keeps scanning while the browser is hidden
+    if (isVisible())
+        refresh();
+}
+
+void IRBrowser::refresh()
+{
+    IRLibrary::Filter filter;
+    filter.text = searchBox.getText();
+    filter.numChannels = channelsBox.getSelectedId() - 1;
+    filter.order = static_cast<IRLibrary::SortOrder>(sortBox.getSelectedId() - 1);
+    shown = library->search(filter);
+
+    // Keep the loaded IR selected without loading it again
+    const juce::ScopedValueSetter<bool> svs (isRefreshing, true);
+    list.updateContent();
+    list.deselectAllRows();
+    for (size_t i = 0; i < shown.size(); ++i)
+        if (shown[i]->file == current)
+        {
+            list.selectRow(static_cast<int>(i));
+            break;
+        }
+    list.repaint();
+
+    const auto total = library->getIndex()->size();
+    statusLabel.setText(juce::String(shown.size()) + " of " + juce::String(total) + " IRs"
+                        + (library->isScanning() ? ", scanning..." : ""), juce::dontSendNotification);
+}
+
+void IRBrowser::paintListBoxItem (int row, juce::Graphics& g, int width, int height, bool isSelected)
+{
+    if (row < 0 || row >= getNumRows())
+        return;
+
+    const auto& entry = *shown[static_cast<size_t>(row)];
+    if (isSelected)
+        g.fillAll(darkPink.withAlpha(0.6f));
+
+    auto area = juce::Rectangle<int>(width, height).reduced(4, 2);
+
+    // Waveform thumbnail: peak per slice, centred
+    auto thumb = area.removeFromRight(IRLibrary::thumbnailSize * 2).toFloat();
+    g.setColour(juce::Colours::white.withAlpha(0.6f));
+    for (int i = 0; i < IRLibrary::thumbnailSize; ++i)
+    {
+        const float h = juce::jmax(1.f, thumb.getHeight() * entry.thumbnail[static_cast<size_t>(i)] / 255.f);
+        g.fillRect(thumb.getX() + 2.f * i, thumb.getCentreY() - h * 0.5f, 1.f, h);
+    }
+    area.removeFromRight(6);
+
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::FontOptions(13.f));
+    g.drawText(entry.name, area.removeFromTop(area.getHeight() / 2), juce::Justification::centredLeft, true);
+
+    const auto info = juce::String(juce::roundToInt(entry.getLengthMs())) + " ms, "
+                    + juce::String(entry.sampleRate / 1000.0, 1) + " kHz, "
+                    + (entry.numChannels > 1 ? "stereo" : "mono") + ", "
+                    + juce::String(entry.centroidHz / 1000.f, 1) + " kHz centroid"
+                    + (entry.folder.isNotEmpty() ? "   " + entry.folder : juce::String());
+    g.setColour(juce::Colours::grey);
+    g.setFont(juce::FontOptions(11.f));
+    g.drawText(info, area, juce::Justification::centredLeft, true);
+}
+
+void IRBrowser::selectedRowsChanged (int lastRowSelected)
+{
+    if (isRefreshing || lastRowSelected < 0 || lastRowSelected >= getNumRows())
+        return;
+
+    // Audition: load as soon as it's selected
+    current = shown[static_cast<size_t>(lastRowSelected)]->file;
+    if (onPick)
+        onPick(current);
+}
+
+void IRBrowser::chooseFolder()
+{
+    folderChooser = std::make_unique<juce::FileChooser>("Add IR Folder", IRLibrary::getDefaultFolder());
+    const auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories;
+
+    folderChooser->launchAsync(flags, [safeThis = juce::Component::SafePointer<IRBrowser>(this)] (const juce::FileChooser& chooser)
+    {
+        const auto folder = chooser.getResult();
+        if (safeThis != nullptr && folder.isDirectory())
+            safeThis->library->addFolder(folder);
+    });
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    IRBrowser.h
+    Created: 19 Oct 2026 9:19:38am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities/IRLibrary.h"
+
+//==============================================================================
+/*
+    IR picker over the shared IRLibrary, shown over the editor's groups by the IR
+    load buttons. Type to filter, sort by name, length or brightness (spectral
+    centroid). Selecting a row loads it straight away, so the arrow keys audition;
+    double-click, Return or Escape closes the browser.
+*/
+class IRBrowser  : public juce::Component,
+                   private juce::ListBoxModel,
+                   private juce::ChangeListener
+{
+public:
+    IRBrowser();
+    ~IRBrowser() override;
+
+    // Called with each IR selected
+    std::function<void(const juce::File&)> onPick;
+    // Opens the plain file chooser, for an IR outside the library
+    std::function<void()> onBrowseFile;
+
+    void show(const juce::File& currentFile);
+    void close() { setVisible(false); }
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    bool keyPressed (const juce::KeyPress&) override;
+
+private:
+    int getNumRows() override { return static_cast<int>(shown.size()); }
+    void paintListBoxItem (int row, juce::Graphics&, int width, int height, bool isSelected) override;
+    void selectedRowsChanged (int lastRowSelected) override;
+    void listBoxItemDoubleClicked (int row, const juce::MouseEvent&) override { close(); }
+    void returnKeyPressed (int) override { close(); }
+
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+    void refresh();
+    void chooseFolder();
+
+    juce::SharedResourcePointer<IRLibrary> library;
+    IRLibrary::Index shown;
+    juce::File current;
+    bool isRefreshing = false;
+
+    juce::TextEditor searchBox;
+    juce::ComboBox sortBox, channelsBox;
+    juce::ListBox list {"IRs", this};
+    juce::TextButton addFolderButton {"Add Folder..."}, otherFileButton {"Other File..."}, closeButton {"Close"};
+    juce::Label statusLabel;
+    std::unique_ptr<juce::FileChooser> folderChooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IRBrowser)
+};
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: 19 Oct 2026 8:39:37am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+
+#if IRFX_ENABLE_PROFILING
+//==============================================================================
+ProfilerOverlay::ProfilerOverlay(Profiling::StageProfiler& p) : profiler(p)
+{
+}
+
+void ProfilerOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void ProfilerOverlay::mouseDown (const juce::MouseEvent&)
+{
+    profiler.reset();
+    timerCallback();
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    for (int s = 0; s < Profiling::numStages; ++s)
+        stats[static_cast<size_t>(s)] = profiler.getStats(static_cast<Profiling::Stage>(s));
+
+    repaint();
+}
+
+void ProfilerOverlay::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.9f));
+    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.f, juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(10);
+    const int rowHeight = 18;
+    const int nameWidth = 90, numberWidth = 70;
+
+    auto drawRow = [&] (juce::StringArray cells, juce::Colour colour, const Profiling::StageStats* rowStats)
+    {
+        auto row = area.removeFromTop(rowHeight);
+        g.setColour(colour);
+        g.drawText(cells[0], row.removeFromLeft(nameWidth), juce::Justification::centredLeft);
+        for (int i = 1; i < cells.size(); ++i)
+            g.drawText(cells[i], row.removeFromLeft(numberWidth), juce::Justification::centredRight);
+
+        // Histogram strip: one column per log2 bucket, height is the share of calls
+        if (rowStats == nullptr || rowStats->count == 0)
+            return;
+
+        row.removeFromLeft(10);
+        const float columnWidth = static_cast<float>(row.getWidth()) / Profiling::numBuckets;
+        for (int b = 0; b < Profiling::numBuckets; ++b)
+        {
+            const auto share = static_cast<float>(rowStats->histogram[static_cast<size_t>(b)]) / static_cast<float>(rowStats->count);
+            const float height = share * static_cast<float>(rowHeight - 4);
+            g.setColour(juce::Colour::fromRGB(200, 30, 100));
+            g.fillRect(static_cast<float>(row.getX()) + b * columnWidth, static_cast<float>(row.getBottom() - 2) - height, columnWidth - 1.f, height);
+        }
+    };
+
+    drawRow({ "Stage", "calls", "mean us", "p99 us", "worst us" }, juce::Colours::grey, nullptr);
+
+    for (int s = 0; s < Profiling::numStages; ++s)
+    {
+        const auto& st = stats[static_cast<size_t>(s)];
+        drawRow({ Profiling::getStageName(static_cast<Profiling::Stage>(s)),
+                  juce::String(static_cast<juce::int64>(st.count)),
+                  juce::String(st.meanMicros, 1),
+                  juce::String(st.percentileMicros(0.99), 1),
+                  juce::String(st.worstMicros, 1) },
+                juce::Colours::white, &st);
+    }
+
+    area.removeFromTop(rowHeight / 2);
+    g.setColour(juce::Colours::grey);
+    g.drawText("Buckets double from 0.5 us. Click to reset.", area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+}
+#endif
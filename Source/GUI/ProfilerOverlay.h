@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: 19 Oct 2026 8:39:37am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities/StageProfiler.h"
+
+#if IRFX_ENABLE_PROFILING
+//==============================================================================
+/*
+    Hidden timing table for profiling builds, toggled from the editor with
+    Cmd/Ctrl + Shift + P. Click it to reset the counters.
+*/
+class ProfilerOverlay  : public juce::Component, private juce::Timer
+{
+public:
+    explicit ProfilerOverlay(Profiling::StageProfiler& profiler);
+
+    void paint (juce::Graphics&) override;
+    void visibilityChanged() override;
+    void mouseDown (const juce::MouseEvent&) override;
+
+private:
+    void timerCallback() override;
+
+    Profiling::StageProfiler& profiler;
+    std::array<Profiling::StageStats, Profiling::numStages> stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerOverlay)
+};
+#endif
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.cpp
+    Created: 19 Oct 2026 8:38:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "SpectrumDisplay.h"
+
+//==============================================================================
+SpectrumDisplay::SpectrumDisplay(SpectrumAnalyzer& a) : analyzer(a)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+SpectrumDisplay::~SpectrumDisplay()
+{
+    stopTimer();
+    analyzer.stop();
+}
+
+void SpectrumDisplay::visibilityChanged()
+{
+    updateRunningState();
+}
+
+void SpectrumDisplay::parentHierarchyChanged()
+{
+    updateRunningState();
+}
+
+void SpectrumDisplay::updateRunningState()
+{
+    if (isShowing())
+    {
+        analyzer.start();
+        startTimerHz(maxFrameRate);
+    }
+    else
+    {
+        stopTimer();
+        analyzer.stop();
+    }
+}
+
+void SpectrumDisplay::timerCallback()
+{
+    // Only repaint when the background thread actually produced something new
+    bool changed = false;
+
+    for (int tap = 0; tap < SpectrumAnalyzer::numTaps; ++tap)
+    {
+        const auto version = analyzer.getPathVersion(static_cast<SpectrumAnalyzer::Tap>(tap));
+        if (version != seenVersions[static_cast<size_t>(tap)])
+        {
+            seenVersions[static_cast<size_t>(tap)] = version;
+            analyzer.copyPath(static_cast<SpectrumAnalyzer::Tap>(tap), paths[static_cast<size_t>(tap)]);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        repaint();
+}
+
+void SpectrumDisplay::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::black.withAlpha(0.85f));
+    g.fillRoundedRectangle(bounds, 6.f);
+
+    // Grid: decades and 12 dB steps
+    g.setColour(juce::Colours::white.withAlpha(0.1f));
+    for (float frequency : { 100.f, 1000.f, 10000.f })
+        g.drawVerticalLine(juce::roundToInt(SpectrumAnalyzer::frequencyToX(frequency) * bounds.getWidth()), bounds.getY(), bounds.getBottom());
+
+    for (float decibels = 0.f; decibels > SpectrumAnalyzer::minDecibels; decibels -= 12.f)
+    {
+        const float y = juce::jmap(decibels, SpectrumAnalyzer::minDecibels, SpectrumAnalyzer::maxDecibels, bounds.getBottom(), bounds.getY());
+        g.drawHorizontalLine(juce::roundToInt(y), bounds.getX(), bounds.getRight());
+    }
+
+    const auto toBounds = juce::AffineTransform::scale(bounds.getWidth(), bounds.getHeight()).translated(bounds.getX(), bounds.getY());
+
+    g.setColour(juce::Colours::grey.withAlpha(0.7f));
+    g.strokePath(paths[SpectrumAnalyzer::pre], juce::PathStrokeType(1.f), toBounds);
+
+    g.setColour(juce::Colour::fromRGB(200, 30, 100));
+    g.strokePath(paths[SpectrumAnalyzer::post], juce::PathStrokeType(1.5f), toBounds);
+
+    g.setColour(juce::Colours::white.withAlpha(0.6f));
+    g.setFont(juce::FontOptions(11.f));
+    g.drawText("IN", bounds.reduced(8.f).removeFromTop(14.f), juce::Justification::topLeft);
+    g.setColour(juce::Colour::fromRGB(200, 30, 100));
+    g.drawText("OUT", bounds.reduced(8.f).removeFromTop(14.f).withTrimmedLeft(24.f), juce::Justification::topLeft);
+}
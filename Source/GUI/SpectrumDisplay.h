@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.h
+    Created: 19 Oct 2026 8:38:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/SpectrumAnalyzer.h"
+//==============================================================================
+/*
+    Draws the analyzer's pre (input) and post (output) curves.
+    Analysis only runs while this component is showing.
+*/
+class SpectrumDisplay  : public juce::Component, private juce::Timer
+{
+public:
+    explicit SpectrumDisplay(SpectrumAnalyzer& analyzer);
+    ~SpectrumDisplay() override;
+
+    void paint (juce::Graphics&) override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+    static constexpr int maxFrameRate = 30;
+
+private:
+    void timerCallback() override;
+    void updateRunningState();
+
+    SpectrumAnalyzer& analyzer;
+    std::array<juce::Path, SpectrumAnalyzer::numTaps> paths;
+    std::array<uint32_t, SpectrumAnalyzer::numTaps> seenVersions {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumDisplay)
+};
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    ParamRegistry.h
+    Created: 19 Oct 2026 8:30:13am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Every parameter is described once here. The layout, the cached pointers,
+// the snapshot and the smoother bank are all generated from this table, so
+// adding a parameter means adding an ID and one table line.
+namespace Params
+{
+    constexpr int versionHint = 1;
+    constexpr float defaultSmoothingSeconds = 0.05f;
+
+    enum ID : int
+    {
+        // === IR Loader ===
+        irBypass,
+        irLowCut,
+        irHighCut,
+        ir1Level,
+        ir2Level,
+        ir1Pan,
+        ir2Pan,
+
+        // === EQ ===
+        eqBypass,
+        eqLowGain,
+        eqMidGain,
+        eqMidFreq,
+        eqHighGain,
+
+        // === Distortion ===
+        distBypass,
+        distDrive,
+        distMix,
+        distMode,
+
+        // === Delay ===
+        delayBypass,
+        delayMix,
+        delayFeedback,
+        delayTime,
+        delayMode,
+        delaySync,
+        delayNote,
+
+        // === In & Out Gain ===
+        inGain,
+        outGain,
+
+        // === General ===
+        pluginBypass,
+        outputMonoStereo,
+
+        numParams
+    };
+
+    enum class Type { floating, boolean, choice };
+    enum class Module { irLoader, toneStack, saturation, delay, general };
+
+    struct Range
+    {
+        float start, end, interval, skew;
+    };
+
+    struct Spec
+    {
+        ID index;
+        const char* id;
+        Type type;
+        Module module;
+        Range range;
+        float defaultValue;
+        float smoothingSeconds;     // 0 = not smoothed
+        const char* const* choices;
+        int numChoices;
+    };
+
+    inline constexpr std::array<const char*, 3> saturationModes { "Neve", "SSL", "API" };
+    inline constexpr std::array<const char*, 2> delayModes { "Digital", "Tape" };
+    inline constexpr std::array<const char*, 8> delaySubdivisions { "1/1", "1/2", "1/4", "1/8", "1/16", "1/4 Dotted", "1/4 Triplet", "1/32" };
+    inline constexpr std::array<const char*, 2> outputModes { "Mono", "Stereo" };
+
+    constexpr Spec floatParam(ID index, const char* id, Module module, Range range, float defaultValue, float smoothingSeconds = defaultSmoothingSeconds)
+    {
+        return { index, id, Type::floating, module, range, defaultValue, smoothingSeconds, nullptr, 0 };
+    }
+
+    constexpr Spec boolParam(ID index, const char* id, Module module, bool defaultValue)
+    {
+        return { index, id, Type::boolean, module, { 0.f, 1.f, 1.f, 1.f }, defaultValue ? 1.f : 0.f, 0.f, nullptr, 0 };
+    }
+
+    template <size_t N>
+    constexpr Spec choiceParam(ID index, const char* id, Module module, const std::array<const char*, N>& choices, int defaultIndex)
+    {
+        return { index, id, Type::choice, module, { 0.f, static_cast<float>(N - 1), 1.f, 1.f }, static_cast<float>(defaultIndex), 0.f, choices.data(), static_cast<int>(N) };
+    }
+
+    inline constexpr std::array<Spec, numParams> table
+    {{
+        boolParam   (irBypass,          "IRBypass",         Module::irLoader,   false),
+        floatParam  (irLowCut,          "IRLowCut",         Module::irLoader,   { 20.f, 1000.f, 1.f, 0.8f }, 20.f),
+        floatParam  (irHighCut,         "IRHighCut",        Module::irLoader,   { 1000.f, 20000.f, 1.f, 1.f }, 20000.f),
+        floatParam  (ir1Level,          "IR1Level",         Module::irLoader,   { -60.f, 0.f, 0.1f, 1.f }, 0.f),
+        floatParam  (ir2Level,          "IR2Level",         Module::irLoader,   { -60.f, 0.f, 0.1f, 1.f }, 0.f),
+        floatParam  (ir1Pan,            "IR1Pan",           Module::irLoader,   { -100.f, 100.f, 1.f, 1.f }, 0.f),
+        floatParam  (ir2Pan,            "IR2Pan",           Module::irLoader,   { -100.f, 100.f, 1.f, 1.f }, 0.f),
+
+        boolParam   (eqBypass,          "EQBypass",         Module::toneStack,  false),
+        floatParam  (eqLowGain,         "EQLowGain",        Module::toneStack,  { -12.f, 12.f, 0.1f, 1.f }, 0.f),
+        floatParam  (eqMidGain,         "EQMidGain",        Module::toneStack,  { -12.f, 12.f, 0.1f, 1.f }, 0.f),
+        floatParam  (eqMidFreq,         "EQMidFreq",        Module::toneStack,  { 250.f, 5000.f, 1.f, 1.f }, 550.f),
+        floatParam  (eqHighGain,        "EQHighGain",       Module::toneStack,  { -12.f, 12.f, 0.1f, 1.f }, 0.f),
+
+        boolParam   (distBypass,        "DistBypass",       Module::saturation, false),
+        floatParam  (distDrive,         "DistDrive",        Module::saturation, { 0.f, 12.f, 0.1f, 1.f }, 6.f),
+        floatParam  (distMix,           "DistMix",          Module::saturation, { 0.f, 100.f, 1.f, 1.f }, 0.f),
+        choiceParam (distMode,          "DistMode",         Module::saturation, saturationModes, 0),
+
+        boolParam   (delayBypass,       "DelayBypass",      Module::delay,      false),
+        floatParam  (delayMix,          "DelayMix",         Module::delay,      { 0.f, 100.f, 1.f, 1.f }, 0.f),
+        floatParam  (delayFeedback,     "DelayFeedback",    Module::delay,      { 0.f, 100.f, 1.f, 1.f }, 30.f),
+        floatParam  (delayTime,         "DelayTime",        Module::delay,      { 1.f, 2000.f, 1.f, 0.5f }, 375.f),
+        choiceParam (delayMode,         "DelayMode",        Module::delay,      delayModes, 0),
+        boolParam   (delaySync,         "DelaySync",        Module::delay,      false),
+        choiceParam (delayNote,         "DelayNote",        Module::delay,      delaySubdivisions, 2),
+
+        floatParam  (inGain,            "InGain",           Module::general,    { -60.f, 12.f, 0.1f, 1.f }, 0.f),
+        floatParam  (outGain,           "OutGain",          Module::general,    { -60.f, 12.f, 0.1f, 1.f }, 0.f),
+
+        boolParam   (pluginBypass,      "PluginBypass",     Module::general,    false),
+        choiceParam (outputMonoStereo,  "OutputMonoStereo", Module::general,    outputModes, 1),
+    }};
+
+    constexpr bool tableIsInIDOrder()
+    {
+        for (int i = 0; i < numParams; ++i)
+            if (table[static_cast<size_t>(i)].index != i)
+                return false;
+        return true;
+    }
+    static_assert(tableIsInIDOrder(), "Params::table entries must follow the ID enum order");
+
+    //==============================================================================
+    // Smoothed parameters are packed into their own dense index range
+    constexpr int countSmoothed()
+    {
+        int count = 0;
+        for (const auto& spec : table)
+            if (spec.smoothingSeconds > 0.f)
+                ++count;
+        return count;
+    }
+
+    constexpr int numSmoothed = countSmoothed();
+
+    constexpr std::array<int, numParams> makeSmootherIndices()
+    {
+        std::array<int, numParams> indices {};
+        int next = 0;
+        for (size_t i = 0; i < table.size(); ++i)
+            indices[i] = table[i].smoothingSeconds > 0.f ? next++ : -1;
+        return indices;
+    }
+
+    constexpr std::array<ID, numSmoothed> makeSmoothedParams()
+    {
+        std::array<ID, numSmoothed> params {};
+        size_t next = 0;
+        for (const auto& spec : table)
+            if (spec.smoothingSeconds > 0.f)
+                params[next++] = spec.index;
+        return params;
+    }
+
+    // smootherIndex[id] is the bank slot of a parameter (-1 if it isn't smoothed)
+    inline constexpr auto smootherIndex = makeSmootherIndices();
+    inline constexpr auto smoothedParams = makeSmoothedParams();
+
+    // Bank bitmask covering the given parameters, for SmootherBank::anyMoved()
+    constexpr uint64_t smootherMask(std::initializer_list<ID> ids)
+    {
+        uint64_t mask = 0;
+        for (auto id : ids)
+            if (smootherIndex[static_cast<size_t>(id)] >= 0)
+                mask |= uint64_t { 1 } << smootherIndex[static_cast<size_t>(id)];
+        return mask;
+    }
+
+    //==============================================================================
+    constexpr const char* getID(ID id)                  { return table[static_cast<size_t>(id)].id; }
+    constexpr const Spec& getSpec(ID id)                { return table[static_cast<size_t>(id)]; }
+    inline juce::ParameterID getParameterID(ID id)      { return { getID(id), versionHint }; }
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.cpp
+    Created: 19 Oct 2026 8:28:29am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "ParamSnapshot.h"
+
+ParamSnapshotSource::ParamSnapshotSource(juce::AudioProcessorValueTreeState& state) : apvts(state)
+{
+    for (const auto& spec : Params::table)
+    {
+        rawValues[static_cast<size_t>(spec.index)] = apvts.getRawParameterValue(spec.id);
+        jassert(rawValues[static_cast<size_t>(spec.index)] != nullptr);
+        apvts.addParameterListener(spec.id, this);
+    }
+}
+
+ParamSnapshotSource::~ParamSnapshotSource()
+{
+    for (const auto& spec : Params::table)
+        apvts.removeParameterListener(spec.id, this);
+}
+
+void ParamSnapshotSource::parameterChanged(const juce::String&, float)
+{
+    markChanged();
+}
+
+void ParamSnapshotSource::setIRLoaded(int irIndex, bool isLoaded)
+{
+    irSlot(irIndex).loaded.store(isLoaded, std::memory_order_relaxed);
+    markChanged();
+}
+
+void ParamSnapshotSource::setIRMuted(int irIndex, bool isMuted)
+{
+    irSlot(irIndex).muted.store(isMuted, std::memory_order_relaxed);
+    markChanged();
+}
+
+bool ParamSnapshotSource::fill(ParamSnapshot& s, bool force) const
+{
+    const auto count = changeCounter.load(std::memory_order_acquire);
+    if (! force && count == s.changeCount)
+        return false;
+
+    for (size_t i = 0; i < rawValues.size(); ++i)
+        s.values[i] = rawValues[i]->load(std::memory_order_relaxed);
+
+    s.ir1Loaded = irSlots[0].loaded.load(std::memory_order_relaxed);
+    s.ir1Muted = irSlots[0].muted.load(std::memory_order_relaxed);
+    s.ir2Loaded = irSlots[1].loaded.load(std::memory_order_relaxed);
+    s.ir2Muted = irSlots[1].muted.load(std::memory_order_relaxed);
+
+    s.changeCount = count;
+    return true;
+}
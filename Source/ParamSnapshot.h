@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.h
+    Created: 19 Oct 2026 8:28:29am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParamRegistry.h"
+
+/**
+ * Every parameter value the audio thread needs for one block.
+ * Filled once at the top of processBlock and only read after that.
+ */
+struct alignas(64) ParamSnapshot
+{
+    // Plain (denormalised) values, indexed by Params::ID
+    std::array<float, Params::numParams> values {};
+
+    // === IR slots (set by the editor/loader, not by the host) ===
+    bool ir1Loaded {false}, ir1Muted {false};
+    bool ir2Loaded {false}, ir2Muted {false};
+
+    uint32_t changeCount {0};
+
+    float get(Params::ID id) const      { return values[static_cast<size_t>(id)]; }
+    bool getBool(Params::ID id) const   { return get(id) >= 0.5f; }
+    int getIndex(Params::ID id) const   { return juce::roundToInt(get(id)); }
+};
+
+
+/**
+ * Owns the thread-safe side of the snapshot: the APVTS raw value atomics,
+ * the IR slot flags and a change counter, so a block where nothing moved
+ * costs one atomic load.
+ */
+class ParamSnapshotSource  : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    explicit ParamSnapshotSource(juce::AudioProcessorValueTreeState& apvts);
+    ~ParamSnapshotSource() override;
+
+    // Returns true if the snapshot was refreshed
+    bool fill(ParamSnapshot& snapshot, bool force = false) const;
+
+    // irIndex is 1 or 2, as in the editor
+    void setIRLoaded(int irIndex, bool isLoaded);
+    void setIRMuted(int irIndex, bool isMuted);
+    bool isIRLoaded(int irIndex) const { return irSlot(irIndex).loaded.load(std::memory_order_relaxed); }
+    bool isIRMuted(int irIndex) const  { return irSlot(irIndex).muted.load(std::memory_order_relaxed); }
+
+private:
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void markChanged() { changeCounter.fetch_add(1, std::memory_order_release); }
+
+    struct IRSlotFlags
+    {
+        std::atomic<bool> loaded {false};
+        std::atomic<bool> muted {false};
+    };
+    const IRSlotFlags& irSlot(int irIndex) const { jassert(irIndex == 1 || irIndex == 2); return irSlots[irIndex == 2 ? 1 : 0]; }
+    IRSlotFlags& irSlot(int irIndex)             { jassert(irIndex == 1 || irIndex == 2); return irSlots[irIndex == 2 ? 1 : 0]; }
+
+    juce::AudioProcessorValueTreeState& apvts;
+    std::array<IRSlotFlags, 2> irSlots;
+    std::atomic<uint32_t> changeCounter {1};
+    std::array<std::atomic<float>*, Params::numParams> rawValues {};
+
+    JUCE_DECLARE_NON_COPYABLE (ParamSnapshotSource)
+};
@@ -44,6 +44,7 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     
 //  PRESET DROPDOWN MENU
     presetBox.setTextWhenNothingSelected("Select Preset");
+    presetBox.setEditableText(true);   // typing filters the list
     presetBox.setColour(juce::ComboBox::ColourIds::backgroundColourId, juce::Colour(100, 100, 110).darker(0.5f));
     presetBox.setColour(juce::ComboBox::ColourIds::outlineColourId, juce::Colours::transparentBlack);
     presetBox.setLookAndFeel(ComboBoxLookAndFeel::get());
@@ -61,6 +62,36 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     }
     addAndMakeVisible(presetBox);
     
+//  SPECTRUM ANALYZER (overlays the top row, analysis only runs while shown)
+    setPresetButtonStyle(spectrumButton);
+    spectrumButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, darkPink);
+    addAndMakeVisible(spectrumButton);
+    addChildComponent(spectrumDisplay);
+    spectrumButton.onClick = [this]
+    {
+        spectrumDisplay.setVisible(spectrumButton.getToggleState());
+        spectrumDisplay.toFront(false);
+    };
+    
+//  IR EMBEDDING
+    setPresetButtonStyle(embedIRButton);
+    embedIRButton.setClickingTogglesState(false);
+    embedIRButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, darkPink);
+    embedIRButton.setToggleState(audioProcessor.getIREmbedMode() != IRArchive::Mode::off, juce::dontSendNotification);
+    embedIRButton.onClick = [this] { showEmbedIRMenu(); };
+    addAndMakeVisible(embedIRButton);
+    
+//  SETTINGS (IR loading and preset switching)
+    setPresetButtonStyle(settingsButton);
+    settingsButton.setClickingTogglesState(false);
+    settingsButton.onClick = [this] { showSettingsMenu(); };
+    addAndMakeVisible(settingsButton);
+    
+   #if IRFX_ENABLE_PROFILING
+    addChildComponent(profilerOverlay);
+   #endif
+    setWantsKeyboardFocus(true);   // diagnostics shortcuts, see keyPressed()
+    
     
 //  delay BUTTONS
     delaySyncButton.setClickingTogglesState(true);
@@ -72,9 +103,9 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     delaySyncButton.onClick = [this]()
     {
         isSyncOn = delaySyncButton.getToggleState();
-        audioProcessor.delaySyncParam->beginChangeGesture();
-        audioProcessor.delaySyncParam->setValueNotifyingHost(isSyncOn);
-        audioProcessor.delaySyncParam->endChangeGesture();
+        audioProcessor.getParam<juce::AudioParameterBool>(Params::delaySync)->beginChangeGesture();
+        audioProcessor.getParam<juce::AudioParameterBool>(Params::delaySync)->setValueNotifyingHost(isSyncOn);
+        audioProcessor.getParam<juce::AudioParameterBool>(Params::delaySync)->endChangeGesture();
         updateDelaySyncState();
     };
     
@@ -88,7 +119,7 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     delayModeBox.setColour(juce::ComboBox::ColourIds::backgroundColourId, darkPink);
     delayModeBox.setColour(juce::ComboBox::ColourIds::outlineColourId, juce::Colours::transparentBlack);
     delayModeBox.setLookAndFeel(ComboBoxLookAndFeel::get());
-    delayModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, ParamNames::getDelayModeName(), delayModeBox);
+    delayModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, Params::getID(Params::delayMode), delayModeBox);
     
     
     
@@ -99,12 +130,12 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     outputMonoStereoBox.setColour(juce::ComboBox::ColourIds::backgroundColourId, juce::Colour(100, 100, 110).darker(0.5f));
     outputMonoStereoBox.setColour(juce::ComboBox::ColourIds::outlineColourId, juce::Colours::transparentBlack);
     outputMonoStereoBox.setLookAndFeel(ComboBoxLookAndFeel::get());
-//    outputMonoStereoBoxAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, ParamNames::getOutputMonoStereoName(), outputMonoStereoBox);
+//    outputMonoStereoBoxAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, Params::getID(Params::outputMonoStereo), outputMonoStereoBox);
     outputMonoStereoBox.onChange = [this]()
     {
-        audioProcessor.outputMonoStereoParam->beginChangeGesture();
-        audioProcessor.outputMonoStereoParam->setValueNotifyingHost(static_cast<float>(outputMonoStereoBox.getSelectedId() - 1));
-        audioProcessor.outputMonoStereoParam->endChangeGesture();
+        audioProcessor.getParam<juce::AudioParameterChoice>(Params::outputMonoStereo)->beginChangeGesture();
+        audioProcessor.getParam<juce::AudioParameterChoice>(Params::outputMonoStereo)->setValueNotifyingHost(static_cast<float>(outputMonoStereoBox.getSelectedId() - 1));
+        audioProcessor.getParam<juce::AudioParameterChoice>(Params::outputMonoStereo)->endChangeGesture();
     };
  
     
@@ -129,6 +160,10 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     irLoader1Button.onClick = [this](){loadIRFile(1);};
     irLoader2Button.onClick = [this](){loadIRFile(2);};
     
+    irBrowser.onPick = [this] (const juce::File& file) { setIRFile(browsingIRIndex, file); };
+    irBrowser.onBrowseFile = [this] { chooseIRFile(browsingIRIndex); };
+    addChildComponent(irBrowser);
+    
 //    IR UNLOAD BUTTONS
     for(auto button : unloadIRButtons)
     {
@@ -143,12 +178,10 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     }
     unloadIR1Button.onClick = [this]
     {
-        if(audioProcessor.isIR1Loaded)
+        if(audioProcessor.isIRLoaded(1))
         {
             loadedIRFile1 = nullptr;
-            audioProcessor.irLoader1->loadImpulseResponse(juce::AudioBuffer<float>(), audioProcessor.getSampleRate(), juce::dsp::Convolution::Stereo::yes, juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
-            audioProcessor.isIR1Loaded = false;
-            audioProcessor.apvts.state.removeProperty("IR1FilePath", nullptr);
+            audioProcessor.unloadIR(1);
             irLoader1Button.setButtonText("Load IR1");
             irLoader1Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white.withAlpha(0.5f));
             ir1LevelSlider.setVisible(false);
@@ -157,12 +190,10 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     };
     unloadIR2Button.onClick = [this]
     {
-        if (audioProcessor.isIR2Loaded)
+        if (audioProcessor.isIRLoaded(2))
         {
             loadedIRFile2 = nullptr;
-            audioProcessor.irLoader2->loadImpulseResponse(juce::AudioBuffer<float>(), audioProcessor.getSampleRate(), juce::dsp::Convolution::Stereo::yes, juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
-            audioProcessor.isIR2Loaded = false;
-            audioProcessor.apvts.state.removeProperty("IR2FilePath", nullptr);
+            audioProcessor.unloadIR(2);
             irLoader2Button.setButtonText("Load IR2");
             irLoader2Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white.withAlpha(0.5f));
             ir2LevelSlider.setVisible(false);
@@ -181,13 +212,15 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
                             0.f);
         button -> setSize(35, 35);
     }
+    muteIR1Button.setToggleState(audioProcessor.isIRMuted(1), juce::dontSendNotification);
+    muteIR2Button.setToggleState(audioProcessor.isIRMuted(2), juce::dontSendNotification);
     muteIR1Button.onClick = [this]
     {
-        audioProcessor.isIR1Muted = !audioProcessor.isIR1Muted;
+        audioProcessor.setIRMuted(1, !audioProcessor.isIRMuted(1));
     };
     muteIR2Button.onClick = [this]
     {
-        audioProcessor.isIR2Muted = !audioProcessor.isIR2Muted;
+        audioProcessor.setIRMuted(2, !audioProcessor.isIRMuted(2));
     };
     
 
@@ -261,6 +294,7 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
     restoreLoadedIRFiles();
     updateDelaySyncState();
 
+    audioProcessor.meterBus.setEnabled(true);
     startTimerHz(60);
     
     // Make sure that before the constructor has finished, you've set the
@@ -270,6 +304,7 @@ IRFxAudioProcessorEditor::IRFxAudioProcessorEditor (IRFxAudioProcessor& p)
 
 IRFxAudioProcessorEditor::~IRFxAudioProcessorEditor()
 {
+    audioProcessor.meterBus.setEnabled(false);
 }
 
 //==============================================================================
@@ -330,6 +365,14 @@ void IRFxAudioProcessorEditor::resized()
     savePresetButton.setBounds(presetBox.getRight() * 1.05, presetBox.getY(), presetBox.getWidth() * 0.5, presetBox.getHeight());
     
     outputMonoStereoBox.setBounds(savePresetButton.getRight() * 1.04, savePresetButton.getY(), savePresetButton.getWidth(), savePresetButton.getHeight());
+    spectrumButton.setBounds(presetBox.getX() - presetBox.getHeight() * 1.6 - 4, presetBox.getY(), presetBox.getHeight() * 1.6, presetBox.getHeight());
+    embedIRButton.setBounds(spectrumButton.getX() - presetBox.getHeight() * 2.2 - 4, presetBox.getY(), presetBox.getHeight() * 2.2, presetBox.getHeight());
+    settingsButton.setBounds(embedIRButton.getX() - presetBox.getHeight() * 2.4 - 4, presetBox.getY(), presetBox.getHeight() * 2.4, presetBox.getHeight());
+    spectrumDisplay.setBounds(IRGroup.getBounds().getUnion(EQGroup.getBounds()));
+   #if IRFX_ENABLE_PROFILING
+    profilerOverlay.setBounds(IRGroup.getBounds().getUnion(delayGroup.getBounds()));
+   #endif
+    irBrowser.setBounds(IRGroup.getBounds().getUnion(delayGroup.getBounds()));
     
 //    IR GROUP
     irBypassButton.setBounds(IRGroup.getWidth() * 0.9, IRGroup.getHeight() * 0.05, bypassButtonSize, bypassButtonSize);
@@ -403,7 +446,14 @@ void IRFxAudioProcessorEditor::resized()
 
 void IRFxAudioProcessorEditor::loadIRFile(int irIndex)
 {
-    fileChooser = std::make_unique<juce::FileChooser> ("Select IR", juce::File::getSpecialLocation(juce::File::userDesktopDirectory), "*.wav");
+    const auto& loaded = irIndex == 1 ? loadedIRFile1 : loadedIRFile2;
+    browsingIRIndex = irIndex;
+    irBrowser.show(loaded != nullptr ? *loaded : juce::File());
+}
+
+void IRFxAudioProcessorEditor::chooseIRFile(int irIndex)
+{
+    fileChooser = std::make_unique<juce::FileChooser> ("Select IR", juce::File::getSpecialLocation(juce::File::userDesktopDirectory), "*.wav;*.aif;*.aiff;*.flac");
 
     auto fileChooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
 
@@ -412,31 +462,32 @@ void IRFxAudioProcessorEditor::loadIRFile(int irIndex)
         juce::File selectedFile = fileChooser.getResult();
         
         if (selectedFile.existsAsFile())
-        {
-            if (irIndex == 1)
-            {
-                loadedIRFile1 = std::make_unique<juce::File>(selectedFile);
-                audioProcessor.loadIR1(*loadedIRFile1);
-                irLoader1Button.setButtonText(loadedIRFile1->getFileName());
-                irLoader1Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-                ir1LevelSlider.setVisible(true);
-            }
-            else if (irIndex == 2)
-            {
-                loadedIRFile2 = std::make_unique<juce::File>(selectedFile);
-                audioProcessor.loadIR2(*loadedIRFile2);
-                irLoader2Button.setButtonText(loadedIRFile2->getFileName());
-                irLoader2Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-                ir2LevelSlider.setVisible(true);
-            }
-        }
+            setIRFile(irIndex, selectedFile);
         else
-        {
             juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Error", "File Could Not Be Loaded");
-        }
     });
 }
 
+void IRFxAudioProcessorEditor::setIRFile(int irIndex, const juce::File& file)
+{
+    if (irIndex == 1)
+    {
+        loadedIRFile1 = std::make_unique<juce::File>(file);
+        audioProcessor.loadIR1(*loadedIRFile1);
+        irLoader1Button.setButtonText(loadedIRFile1->getFileName());
+        irLoader1Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
+        ir1LevelSlider.setVisible(true);
+    }
+    else if (irIndex == 2)
+    {
+        loadedIRFile2 = std::make_unique<juce::File>(file);
+        audioProcessor.loadIR2(*loadedIRFile2);
+        irLoader2Button.setButtonText(loadedIRFile2->getFileName());
+        irLoader2Button.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
+        ir2LevelSlider.setVisible(true);
+    }
+}
+
 void IRFxAudioProcessorEditor::restoreLoadedIRFiles()
 {
     auto ir1Path = audioProcessor.apvts.state.getProperty("IR1FilePath", "").toString();
@@ -473,7 +524,7 @@ void IRFxAudioProcessorEditor::restoreLoadedIRFiles()
 void IRFxAudioProcessorEditor::timerCallback()
 {
 //    SAT TYPE
-    auto currentSatMode = audioProcessor.saturationModeParam->getIndex();
+    auto currentSatMode = audioProcessor.getParam<juce::AudioParameterChoice>(Params::distMode)->getIndex();
     switch (currentSatMode)
     {
         case 0:
@@ -507,8 +558,12 @@ void IRFxAudioProcessorEditor::timerCallback()
 
 // === Clipping light logic ===
     
-    bool inClipping = audioProcessor.clipFlagIn.exchange(false);
-    bool outClipping = audioProcessor.clipFlagOut.exchange(false);
+    bool inClipping = false, outClipping = false;
+    audioProcessor.meterBus.drain([&] (const MeterBus::Frame& frame)
+    {
+        inClipping |= frame.stages[MeterBus::input].isClipping();
+        outClipping |= frame.stages[MeterBus::output].isClipping();
+    });
     if (inClipping)
         inputGainSlider.setClippingStatus(true);
     if (outClipping)
@@ -543,7 +598,7 @@ void IRFxAudioProcessorEditor::timerCallback()
 
 void IRFxAudioProcessorEditor::updateDelaySyncState()
 {
-    isSyncOn = audioProcessor.delaySyncParam->get();
+    isSyncOn = audioProcessor.getParam<juce::AudioParameterBool>(Params::delaySync)->get();
     delaySyncButton.setToggleState(isSyncOn, juce::dontSendNotification);
     setSatButtonColour(delaySyncButton, isSyncOn);
     delayTimeKnob.setVisible(!isSyncOn);
@@ -565,9 +620,10 @@ void IRFxAudioProcessorEditor::clipLight(juce::Graphics& g)
 
 void IRFxAudioProcessorEditor::setSaturationType(int type)
 {
-    audioProcessor.saturationModeParam->beginChangeGesture();
-    audioProcessor.saturationModeParam->setValueNotifyingHost(audioProcessor.saturationModeParam->convertTo0to1(type));
-    audioProcessor.saturationModeParam->endChangeGesture();
+    auto* saturationModeParam = audioProcessor.getParam<juce::AudioParameterChoice>(Params::distMode);
+    saturationModeParam->beginChangeGesture();
+    saturationModeParam->setValueNotifyingHost(saturationModeParam->convertTo0to1(type));
+    saturationModeParam->endChangeGesture();
     
     setSatButtonColour(sat1Button, sat1Button.getToggleState());
     setSatButtonColour(sat2Button, sat2Button.getToggleState());
@@ -584,6 +640,114 @@ void IRFxAudioProcessorEditor::setSatButtonColour (juce::TextButton& b, bool isO
         b.setColour(juce::TextButton::ColourIds::buttonColourId, darkPink.withAlpha(0.5f));
 }
 
+bool IRFxAudioProcessorEditor::keyPressed (const juce::KeyPress& key)
+{
+    const auto commandShift = juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier;
+
+    // Cmd/Ctrl + Shift + T: start tracing, or write what has been traced so far
+    if (key == juce::KeyPress('t', commandShift, 0))
+    {
+        auto& tracer = audioProcessor.tracer;
+        if (! tracer.isEnabled())
+        {
+            tracer.setEnabled(true);
+            return true;
+        }
+
+        if (auto file = tracer.dumpNow("manual"); file.existsAsFile())
+            file.revealToUser();
+        return true;
+    }
+
+   #if IRFX_ENABLE_PROFILING
+    if (key == juce::KeyPress('p', commandShift, 0))
+    {
+        profilerOverlay.setVisible(! profilerOverlay.isVisible());
+        profilerOverlay.toFront(false);
+        return true;
+    }
+   #endif
+
+    return false;
+}
+
+namespace
+{
+    struct MorphTime
+    {
+        float seconds;
+        const char* name;
+    };
+    
+    constexpr std::array<MorphTime, 6> presetMorphTimes {{ { 0.f, "Off" }, { 0.1f, "100 ms" }, { 0.25f, "250 ms" },
+                                                           { 0.5f, "500 ms" }, { 1.f, "1 s" }, { 2.f, "2 s" } }};
+    
+    constexpr std::array<size_t, 5> irCacheSizesMB { 64, 128, 256, 512, 1024 };
+}
+
+void IRFxAudioProcessorEditor::showEmbedIRMenu()
+{
+    using Mode = IRArchive::Mode;
+    const auto current = audioProcessor.getIREmbedMode();
+    
+    juce::PopupMenu menu;
+    menu.addSectionHeader("IRs in session");
+    menu.addItem(1, "File paths only", true, current == Mode::off);
+    menu.addItem(2, "Embed audio (WAV)", true, current == Mode::uncompressed);
+    menu.addItem(3, "Embed audio (lossless FLAC, smaller)", true, current == Mode::compressed);
+    
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(embedIRButton),
+                       [safeThis = juce::Component::SafePointer<IRFxAudioProcessorEditor>(this)] (int result)
+    {
+        if (safeThis == nullptr || result == 0)
+            return;
+        
+        const auto mode = static_cast<Mode>(result - 1);
+        safeThis->audioProcessor.setIREmbedMode(mode);
+        safeThis->embedIRButton.setToggleState(mode != Mode::off, juce::dontSendNotification);
+    });
+}
+
+void IRFxAudioProcessorEditor::showSettingsMenu()
+{
+    juce::PopupMenu menu;
+    const auto restoreOutput = audioProcessor.getRestoreOutput();
+    menu.addSectionHeader("While IRs load");
+    menu.addItem(11, "Pass dry signal", true, restoreOutput == RestoreGate::Mode::dry);
+    menu.addItem(12, "Silence", true, restoreOutput == RestoreGate::Mode::silence);
+    
+    const auto morphSeconds = audioProcessor.getPresetMorphSeconds();
+    menu.addSectionHeader("Preset switch morph");
+    for (size_t i = 0; i < presetMorphTimes.size(); ++i)
+        menu.addItem(21 + static_cast<int>(i), presetMorphTimes[i].name, true, juce::approximatelyEqual(morphSeconds, presetMorphTimes[i].seconds));
+    
+    const auto cacheMB = audioProcessor.getIRCacheLimitBytes() / (1024 * 1024);
+    menu.addSectionHeader("IR cache (all instances)");
+    for (size_t i = 0; i < irCacheSizesMB.size(); ++i)
+        menu.addItem(31 + static_cast<int>(i), juce::String(irCacheSizesMB[i]) + " MB", true, cacheMB == irCacheSizesMB[i]);
+    
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(settingsButton),
+                       [safeThis = juce::Component::SafePointer<IRFxAudioProcessorEditor>(this)] (int result)
+    {
+        if (safeThis == nullptr || result == 0)
+            return;
+        
+        if (result >= 31)
+        {
+            safeThis->audioProcessor.setIRCacheLimitBytes(irCacheSizesMB[static_cast<size_t>(result - 31)] * 1024 * 1024);
+            return;
+        }
+        
+        if (result >= 21)
+        {
+            safeThis->audioProcessor.setPresetMorphSeconds(presetMorphTimes[static_cast<size_t>(result - 21)].seconds);
+            return;
+        }
+        
+        safeThis->audioProcessor.setRestoreOutput(static_cast<RestoreGate::Mode>(result - 11));
+    });
+}
+
 void IRFxAudioProcessorEditor::setPresetButtonStyle(juce::TextButton& button)
 {
     button.setClickingTogglesState(true);
@@ -14,8 +14,11 @@
 #include "GUI/BypassButton.h"
 #include "GUI/HorizontalSlider.h"
 #include "GUI/GainSlider.h"
+#include "GUI/SpectrumDisplay.h"
+#include "GUI/ProfilerOverlay.h"
+#include "GUI/IRBrowser.h"
 #include "Utilities/PresetManager.h"
-#include "ParamNames.h"
+#include "ParamRegistry.h"
 
 
 //==============================================================================
@@ -41,8 +44,8 @@ private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     IRFxAudioProcessor& audioProcessor;
-    const int versionHint = 1;
     void timerCallback() override;
+    bool keyPressed (const juce::KeyPress&) override;
    
     
     juce::Image backgroundImg = juce::ImageCache::getFromMemory(BinaryData::BlackSnakeskin_png, BinaryData::BlackSnakeskin_pngSize);
@@ -64,31 +67,37 @@ private:
     std::unique_ptr<juce::File> loadedIRFile1 {nullptr}, loadedIRFile2 {nullptr};
     std::unique_ptr<juce::FileChooser> fileChooser;
     
-    HorizontalSlider ir1LevelSlider {"IR1 Level", audioProcessor.apvts, juce::ParameterID(ParamNames::getIR1LevelName(), versionHint), " dB"};
-    HorizontalSlider ir2LevelSlider {"IR2 Level", audioProcessor.apvts, juce::ParameterID(ParamNames::getIR2LevelName(), versionHint), " dB"};
+//    IR BROWSER (opened by the load buttons)
+    IRBrowser irBrowser;
+    int browsingIRIndex = 1;
+    void chooseIRFile(int irIndex);
+    void setIRFile(int irIndex, const juce::File& file);
+    
+    HorizontalSlider ir1LevelSlider {"IR1 Level", audioProcessor.apvts, Params::getParameterID(Params::ir1Level), " dB"};
+    HorizontalSlider ir2LevelSlider {"IR2 Level", audioProcessor.apvts, Params::getParameterID(Params::ir2Level), " dB"};
     
     void restoreLoadedIRFiles();
     
 //    knobImage Dials
     const juce::Image knobImage {juce::ImageCache::getFromMemory(BinaryData::Knob_10brighter_png, BinaryData::Knob_10brighter_pngSize)};
     
-    ImageKnob lowCutSlider{"LowCut", audioProcessor.apvts, juce::ParameterID(ParamNames::getIRLowCutName(), versionHint), knobImage, " Hz", 80};
-    ImageKnob highCutSlider{"HighCut", audioProcessor.apvts, juce::ParameterID(ParamNames::getIRHighCutName(), versionHint), knobImage, " Hz", 80};
-    ImageKnob ir1PanSlider{"IR1 Pan", audioProcessor.apvts, juce::ParameterID(ParamNames::getIR1PanName(), versionHint), knobImage, " %", 35, true, false};
-    ImageKnob ir2PanSlider{"IR2 Pan", audioProcessor.apvts, juce::ParameterID(ParamNames::getIR2PanName(), versionHint), knobImage, " %", 35, true, false};
+    ImageKnob lowCutSlider{"LowCut", audioProcessor.apvts, Params::getParameterID(Params::irLowCut), knobImage, " Hz", 80};
+    ImageKnob highCutSlider{"HighCut", audioProcessor.apvts, Params::getParameterID(Params::irHighCut), knobImage, " Hz", 80};
+    ImageKnob ir1PanSlider{"IR1 Pan", audioProcessor.apvts, Params::getParameterID(Params::ir1Pan), knobImage, " %", 35, true, false};
+    ImageKnob ir2PanSlider{"IR2 Pan", audioProcessor.apvts, Params::getParameterID(Params::ir2Pan), knobImage, " %", 35, true, false};
     
-    ImageKnob lowEQGainSlider{"Bass", audioProcessor.apvts, juce::ParameterID(ParamNames::getEQLowGainName(), versionHint), knobImage, " dB", 80, true};
-    ImageKnob midEQGainSlider{"Mid", audioProcessor.apvts, juce::ParameterID(ParamNames::getEQMidGainName(), versionHint), knobImage, " dB", 80, true};
-    ImageKnob midEQFreqSlider{"Mid Freq", audioProcessor.apvts, juce::ParameterID(ParamNames::getEQMidFreqName(), versionHint), knobImage, " Hz", 80, false};
-    ImageKnob highEQGainSlider{"Treble", audioProcessor.apvts, juce::ParameterID(ParamNames::getEQHighGainName(), versionHint), knobImage, " dB", 80, true};
+    ImageKnob lowEQGainSlider{"Bass", audioProcessor.apvts, Params::getParameterID(Params::eqLowGain), knobImage, " dB", 80, true};
+    ImageKnob midEQGainSlider{"Mid", audioProcessor.apvts, Params::getParameterID(Params::eqMidGain), knobImage, " dB", 80, true};
+    ImageKnob midEQFreqSlider{"Mid Freq", audioProcessor.apvts, Params::getParameterID(Params::eqMidFreq), knobImage, " Hz", 80, false};
+    ImageKnob highEQGainSlider{"Treble", audioProcessor.apvts, Params::getParameterID(Params::eqHighGain), knobImage, " dB", 80, true};
        
-    ImageKnob saturationKnob{"Drive", audioProcessor.apvts, juce::ParameterID(ParamNames::getDistDriveName(), versionHint), knobImage, "", 110};
-    ImageKnob saturationMixKnob{"Mix", audioProcessor.apvts, juce::ParameterID(ParamNames::getDistMixName(), versionHint), knobImage, " %", 110};
+    ImageKnob saturationKnob{"Drive", audioProcessor.apvts, Params::getParameterID(Params::distDrive), knobImage, "", 110};
+    ImageKnob saturationMixKnob{"Mix", audioProcessor.apvts, Params::getParameterID(Params::distMix), knobImage, " %", 110};
     
-    ImageKnob delayMixKnob{"Mix", audioProcessor.apvts, juce::ParameterID(ParamNames::getDelayMixName(), versionHint), knobImage, " %", 80};
-    ImageKnob delayFeedbackKnob{"Feedback", audioProcessor.apvts, juce::ParameterID(ParamNames::getDelayFeedbackName(), versionHint), knobImage, " %", 80};
-    ImageKnob delayTimeKnob{"Time", audioProcessor.apvts, juce::ParameterID(ParamNames::getDelayTimeName(), versionHint), knobImage, " ms", 80};
-    ImageKnob delayNoteKnob{"Notes", audioProcessor.apvts, juce::ParameterID(ParamNames::getDelayNoteName(), versionHint), knobImage, "", 80};
+    ImageKnob delayMixKnob{"Mix", audioProcessor.apvts, Params::getParameterID(Params::delayMix), knobImage, " %", 80};
+    ImageKnob delayFeedbackKnob{"Feedback", audioProcessor.apvts, Params::getParameterID(Params::delayFeedback), knobImage, " %", 80};
+    ImageKnob delayTimeKnob{"Time", audioProcessor.apvts, Params::getParameterID(Params::delayTime), knobImage, " ms", 80};
+    ImageKnob delayNoteKnob{"Notes", audioProcessor.apvts, Params::getParameterID(Params::delayNote), knobImage, "", 80};
     
 //    Dials Name Labels
     juce::Label lowCutSliderLabel {"Low Cut"};
@@ -127,11 +136,11 @@ private:
     };
     
 //   Bypass Buttons
-    BypassButton irBypassButton{"IR Bypass Button", audioProcessor.apvts, juce::ParameterID(ParamNames::getIRBypassName(),versionHint)};
-    BypassButton eqBypassButton{"EQ Bypass Button", audioProcessor.apvts, juce::ParameterID(ParamNames::getEQBypassName(),versionHint)};
-    BypassButton distBypassButton{"Dist Bypass Button", audioProcessor.apvts, juce::ParameterID(ParamNames::getDistBypassName(),versionHint)};
-    BypassButton delayBypassButton{"Delay Bypass Button", audioProcessor.apvts, juce::ParameterID(ParamNames::getDelayBypassName(),versionHint)};
-    BypassButton generalBypassButton{"General Bypass Button", audioProcessor.apvts, juce::ParameterID(ParamNames::getGeneralBypassName(), versionHint)};
+    BypassButton irBypassButton{"IR Bypass Button", audioProcessor.apvts, Params::getParameterID(Params::irBypass)};
+    BypassButton eqBypassButton{"EQ Bypass Button", audioProcessor.apvts, Params::getParameterID(Params::eqBypass)};
+    BypassButton distBypassButton{"Dist Bypass Button", audioProcessor.apvts, Params::getParameterID(Params::distBypass)};
+    BypassButton delayBypassButton{"Delay Bypass Button", audioProcessor.apvts, Params::getParameterID(Params::delayBypass)};
+    BypassButton generalBypassButton{"General Bypass Button", audioProcessor.apvts, Params::getParameterID(Params::pluginBypass)};
     
 //  Unload IR Buttons
     juce::ImageButton unloadIR1Button, unloadIR2Button;
@@ -169,8 +178,8 @@ private:
     
     
 //    INPUT & OUTPUT GAIN SLIDERS
-    GainSlider inputGainSlider {"Input Gain", audioProcessor.apvts, juce::ParameterID(ParamNames::getInGainName(), versionHint), " dB [IN]", juce::Slider::TextEntryBoxPosition::TextBoxRight};
-    GainSlider outputGainSlider {"Output Gain", audioProcessor.apvts, juce::ParameterID(ParamNames::getOutGainName(), versionHint), " dB [OUT]", juce::Slider::TextEntryBoxPosition::TextBoxLeft};
+    GainSlider inputGainSlider {"Input Gain", audioProcessor.apvts, Params::getParameterID(Params::inGain), " dB [IN]", juce::Slider::TextEntryBoxPosition::TextBoxRight};
+    GainSlider outputGainSlider {"Output Gain", audioProcessor.apvts, Params::getParameterID(Params::outGain), " dB [OUT]", juce::Slider::TextEntryBoxPosition::TextBoxLeft};
     bool isClippingLightOn = false;
     int clipLightHoldCounter = 0; // counts down in timer ticks
     float clipPopScale = 1.0f;
@@ -182,6 +191,23 @@ private:
     juce::TextButton savePresetButton {"Save"};
     void setPresetButtonStyle(juce::TextButton&);
     
+//    IR EMBEDDING (whether sessions carry the IR audio)
+    juce::TextButton embedIRButton {"Embed"};
+    void showEmbedIRMenu();
+    
+//    SETTINGS (output while IRs load, preset morph time, IR cache size)
+    juce::TextButton settingsButton {"Settings"};
+    void showSettingsMenu();
+    
+//    SPECTRUM ANALYZER
+    juce::TextButton spectrumButton {"FFT"};
+    SpectrumDisplay spectrumDisplay {audioProcessor.spectrumAnalyzer};
+    
+   #if IRFX_ENABLE_PROFILING
+//    STAGE TIMING OVERLAY (Cmd/Ctrl + Shift + P)
+    ProfilerOverlay profilerOverlay {audioProcessor.profiler};
+   #endif
+    
 //    OUTPUT MONO/STEREO
     juce::ComboBox outputMonoStereoBox;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> outputMonoStereoBoxAttachment;
@@ -7,7 +7,9 @@
 */
 
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#if ! IRFX_HEADLESS
+ #include "PluginEditor.h"
+#endif
 
 //==============================================================================
 IRFxAudioProcessor::IRFxAudioProcessor()
@@ -22,128 +24,11 @@ IRFxAudioProcessor::IRFxAudioProcessor()
                        )
 #endif
 {
-
-//============ FLOAT PARAMS ============
-    auto floatParams = std::array
-    {
-//        IR LOADER
-        &lowCutFreqParam,
-        &highCutFreqParam,
-        &ir1LevelParam,
-        &ir2LevelParam,
-        &ir1PanParam,
-        &ir2PanParam,
-        
-//        EQ
-        &lowEQGainParam,
-        &midEQGainParam,
-        &midEQFreqParam,
-        &highEQGainParam,
-        
-//        SAT
-        &saturationDriveParam,
-        &saturationMixParam,
-        
-//        DELAY
-        &delayMixParam,
-        &delayFeedbackParam,
-        &delayTimeParam,
-
-        
-//        IN-OUT GAIN
-        &inputGainParam,
-        &outputGainParam,
-    };
-    
-    auto floatNameFuncs = std::array
+    for (const auto& spec : Params::table)
     {
-        //        IR LOADER
-        &ParamNames::getIRLowCutName,
-        &ParamNames::getIRHighCutName,
-        &ParamNames::getIR1LevelName,
-        &ParamNames::getIR2LevelName,
-        &ParamNames::getIR1PanName,
-        &ParamNames::getIR2PanName,
-        
-        //        EQ
-        &ParamNames::getEQLowGainName,
-        &ParamNames::getEQMidGainName,
-        &ParamNames::getEQMidFreqName,
-        &ParamNames::getEQHighGainName,
-        
-        //        SAT
-        &ParamNames::getDistDriveName,
-        &ParamNames::getDistMixName,
-        
-        //        DELAY
-        &ParamNames::getDelayMixName,
-        &ParamNames::getDelayFeedbackName,
-        &ParamNames::getDelayTimeName,
-        
-        //        IN-OUT GAIN
-        &ParamNames::getInGainName,
-        &ParamNames::getOutGainName,
-    };
-    
-    initCachedParams<juce::AudioParameterFloat*>(floatParams, floatNameFuncs);
-    
-    
-    //============ BOOL PARAMS ============
-    auto boolParams = std::array
-    {
-        //        IR LOADER
-        &irLoaderBypassParam,
-        //        EQ
-        &eqBypassParam,
-        //        SAT
-        &saturationBypassParam,
-        //        DELAY
-        &delayBypassParam,
-        &delaySyncParam,
-        
-        &pluginBypassParam,
-    };
-    
-    auto boolNameFuncs = std::array
-    {
-        //        IR LOADER
-        &ParamNames::getIRBypassName,
-        //        EQ
-        &ParamNames::getEQBypassName,
-        
-        //        SAT
-        &ParamNames::getDistBypassName,
-        //        DELAY
-        &ParamNames::getDelayBypassName,
-        &ParamNames::getDelaySyncName,
-        
-        &ParamNames::getGeneralBypassName,
-    };
-    
-    initCachedParams<juce::AudioParameterBool*>(boolParams, boolNameFuncs);
-    
-    //============ CHOICE PARAMS ============
-    auto choiceParams = std::array
-    {
-//        DIST
-        &saturationModeParam,
-//        DELAY
-        &delayModeParam,
-        &delayNoteParam,
-        
-        &outputMonoStereoParam,
-    };
-    
-    auto choiceNameFuncs = std::array
-    {
-        &ParamNames::getDistModeName,
-        &ParamNames::getDelayModeName,
-        &ParamNames::getDelayNoteName,
-        &ParamNames::getOutputMonoStereoName,
-    };
-    
-    initCachedParams<juce::AudioParameterChoice*>(choiceParams, choiceNameFuncs);
-    
+        cachedParams[static_cast<size_t>(spec.index)] = apvts.getParameter(spec.id);
+        jassert(cachedParams[static_cast<size_t>(spec.index)] != nullptr);
+    }
 }
 
 IRFxAudioProcessor::~IRFxAudioProcessor()
@@ -153,7 +38,11 @@ IRFxAudioProcessor::~IRFxAudioProcessor()
 //==============================================================================
 const juce::String IRFxAudioProcessor::getName() const
 {
+   #ifdef JucePlugin_Name
     return JucePlugin_Name;
+   #else
+    return "IRFx";
+   #endif
 }
 
 bool IRFxAudioProcessor::acceptsMidi() const
@@ -216,87 +105,29 @@ void IRFxAudioProcessor::changeProgramName (int index, const juce::String& newNa
 juce::AudioProcessorValueTreeState::ParameterLayout IRFxAudioProcessor::createParameterLayout()
 {
     std::vector <std::unique_ptr<juce::RangedAudioParameter>> params;
-    const int versionHint = 1;
-    
-//    IR Loader
-    auto name = ParamNames::getIRBypassName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    name = ParamNames::getIRLowCutName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(20.f, 1000.f, 1.f, 0.8f), 20.f));
-    name = ParamNames::getIRHighCutName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(1000.f, 20000.f, 1.f, 1.f), 20000.f));
-    name = ParamNames::getIR1LevelName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-60.f, 0.f, 0.1f, 1.f), 0.f));
-    name = ParamNames::getIR2LevelName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-60.f, 0.f, 0.1f, 1.f), 0.f));
-    name = ParamNames::getIR1PanName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-100.f, 100.f, 1.f, 1.f), 0.f));
-    name = ParamNames::getIR2PanName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-100.f, 100.f, 1.f, 1.f), 0.f));
-    
-//   EQ
-    name = ParamNames::getEQBypassName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    name = ParamNames::getEQLowGainName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-12.f, 12.f, 0.1f, 1.f), 0.f));
-    name = ParamNames::getEQMidGainName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-12.f, 12.f, 0.1f, 1.f), 0.f));
-    name = ParamNames::getEQMidFreqName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(250.f, 5000.f, 1.f, 1.f), 550.f));
-    name = ParamNames::getEQHighGainName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-12.f, 12.f, 0.1f, 1.f), 0.f));
-    
-//   DIST
-    name = ParamNames::getDistBypassName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    name = ParamNames::getDistDriveName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(0.f, 12.f, 0.1f, 1.f), 6.f));
-    name = ParamNames::getDistMixName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(0.f, 100.f, 1.f, 1.f), 0.f));
-    name = ParamNames::getDistModeName();
-    juce::StringArray choices;
-    choices.add("Neve");
-    choices.add("SSL");
-    choices.add("API");
-    params.emplace_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(name, versionHint), name, choices, 0));
-    
-//   DELAY
-    name = ParamNames::getDelayBypassName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    name = ParamNames::getDelayMixName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(0.f, 100.f, 1.f, 1.f), 0.f));
-    name = ParamNames::getDelayFeedbackName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(0.f, 100.f, 1.f, 1.f), 30.f));
-    name = ParamNames::getDelayTimeName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(1.f, 2000.f, 1.f, 0.5f), 375.f));
-    name = ParamNames::getDelayModeName();
-    juce::StringArray delayModes;
-    delayModes.add("Digital");
-    delayModes.add("Tape");
-    params.emplace_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(name, versionHint), name, delayModes, 0));
-    name = ParamNames::getDelaySyncName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    name = ParamNames::getDelayNoteName();
-    juce::StringArray subdivisionArray { "1/1", "1/2", "1/4", "1/8", "1/16", "1/4 Dotted", "1/4 Triplet", "1/32"};
-    params.emplace_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(name, versionHint), name, subdivisionArray, 2));
-
-    
-//   IN-OUT GAIN
-    name = ParamNames::getInGainName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-60.f, 12.f, 0.1f, 1.f), 0.f));
-    name = ParamNames::getOutGainName();
-    params.emplace_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name, versionHint), name, juce::NormalisableRange<float>(-60.f, 12.f, 0.1f, 1.f), 0.f));
-    
-    
-//   PLUGIN BYPASS
-    name = ParamNames::getGeneralBypassName();
-    params.emplace_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(name, versionHint), name, false));
-    
-//    PLUGIN OUTPUT
-    name = ParamNames::getOutputMonoStereoName();
-    juce::StringArray outputMonoStereoArray {"Mono", "Stereo"};
-    params.emplace_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(name, versionHint), name, outputMonoStereoArray, 1));
+    params.reserve(Params::table.size());
     
+    for (const auto& spec : Params::table)
+    {
+        const auto paramID = juce::ParameterID(spec.id, Params::versionHint);
+        const juce::String name (spec.id);
+        
+        switch (spec.type)
+        {
+            case Params::Type::floating:
+            {
+                const auto& r = spec.range;
+                params.emplace_back(std::make_unique<juce::AudioParameterFloat>(paramID, name, juce::NormalisableRange<float>(r.start, r.end, r.interval, r.skew), spec.defaultValue));
+                break;
+            }
+            case Params::Type::boolean:
+                params.emplace_back(std::make_unique<juce::AudioParameterBool>(paramID, name, spec.defaultValue >= 0.5f));
+                break;
+            case Params::Type::choice:
+                params.emplace_back(std::make_unique<juce::AudioParameterChoice>(paramID, name, juce::StringArray(spec.choices, spec.numChoices), static_cast<int>(spec.defaultValue)));
+                break;
+        }
+    }
 
     return {params.begin(), params.end()};
 }
@@ -304,41 +135,54 @@ juce::AudioProcessorValueTreeState::ParameterLayout IRFxAudioProcessor::createPa
 void IRFxAudioProcessor::updateParams()
 {
     auto sampleRate = getSampleRate();
-    using Coefficients = juce::dsp::IIR::Coefficients<float>;
+    // make* on ArrayCoefficients returns plain arrays, copied into the existing coefficient
+    // objects; Coefficients::make* would heap-allocate on the audio thread
+    using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+    
+    // Coefficients are only rebuilt for filters whose parameters actually moved this block
+    constexpr auto irEQMask = Params::smootherMask({ Params::irLowCut, Params::irHighCut });
+    constexpr auto toneStackMask = Params::smootherMask({ Params::eqLowGain, Params::eqMidGain, Params::eqMidFreq, Params::eqHighGain });
     
 //    IR LOADER
-    auto lowCutCoefficients = Coefficients::makeHighPass(sampleRate, lowCutFreqParamSmoother.getCurrentValue());
-    auto highCutCoefficients = Coefficients::makeLowPass(sampleRate, highCutFreqParamSmoother.getCurrentValue());
-
-    for (auto& chain : irEQMonoChainArray)
+    if (smoothers.anyMoved(irEQMask))
     {
-        auto& lowCut = chain.template get<0>();
-        auto& highCut = chain.template get<1>();
+        tracer.instant(TraceRecorder::Event::coefficientUpdate, 0.f);
+        const auto lowCutCoefficients = ArrayCoefficients::makeHighPass(sampleRate, getSmoothedValue(Params::irLowCut));
+        const auto highCutCoefficients = ArrayCoefficients::makeLowPass(sampleRate, getSmoothedValue(Params::irHighCut));
         
-        *lowCut.coefficients = *lowCutCoefficients;
-        *highCut.coefficients = *highCutCoefficients;
+        for (auto& chain : irEQMonoChainArray)
+        {
+            auto& lowCut = chain.template get<0>();
+            auto& highCut = chain.template get<1>();
+            
+            *lowCut.coefficients = lowCutCoefficients;
+            *highCut.coefficients = highCutCoefficients;
+        }
     }
     
 //    EQ STACK
-    lowShelfGain = juce::Decibels::decibelsToGain(lowEQGainParamSmoother.getCurrentValue());
-    midPeakGain = juce::Decibels::decibelsToGain(midEQGainParamSmoother.getCurrentValue());
-    midPeakFreq = midEQFreqParamSmoother.getCurrentValue();
-    highShelfGain = juce::Decibels::decibelsToGain(highEQGainParamSmoother.getCurrentValue());
-    
-    auto lowEQCoefficients = Coefficients::makeLowShelf(sampleRate, 110.f, 0.707f, lowShelfGain);
-    
-    auto midEQCoefficients = Coefficients::makePeakFilter(sampleRate, midPeakFreq, 1.f, midPeakGain);
-    auto highEQCoefficients = Coefficients::makeHighShelf(sampleRate, 4500.f, 0.707f, highShelfGain);
-    
-    for (auto& chain : toneStackMonoChainAray)
+    if (smoothers.anyMoved(toneStackMask))
     {
-        auto& lowShelf = chain.template get<0>();
-        auto& midPeak = chain.template get<1>();
-        auto& highShelf = chain.template get<2>();
+        tracer.instant(TraceRecorder::Event::coefficientUpdate, 1.f);
+        lowShelfGain = juce::Decibels::decibelsToGain(getSmoothedValue(Params::eqLowGain));
+        midPeakGain = juce::Decibels::decibelsToGain(getSmoothedValue(Params::eqMidGain));
+        midPeakFreq = getSmoothedValue(Params::eqMidFreq);
+        highShelfGain = juce::Decibels::decibelsToGain(getSmoothedValue(Params::eqHighGain));
         
-        *lowShelf.coefficients = *lowEQCoefficients;
-        *midPeak.coefficients = *midEQCoefficients;
-        *highShelf.coefficients = *highEQCoefficients;
+        const auto lowEQCoefficients = ArrayCoefficients::makeLowShelf(sampleRate, 110.f, 0.707f, lowShelfGain);
+        const auto midEQCoefficients = ArrayCoefficients::makePeakFilter(sampleRate, midPeakFreq, 1.f, midPeakGain);
+        const auto highEQCoefficients = ArrayCoefficients::makeHighShelf(sampleRate, 4500.f, 0.707f, highShelfGain);
+        
+        for (auto& chain : toneStackMonoChainAray)
+        {
+            auto& lowShelf = chain.template get<0>();
+            auto& midPeak = chain.template get<1>();
+            auto& highShelf = chain.template get<2>();
+            
+            *lowShelf.coefficients = lowEQCoefficients;
+            *midPeak.coefficients = midEQCoefficients;
+            *highShelf.coefficients = highEQCoefficients;
+        }
     }
 }
 //==============================================================================
@@ -349,13 +193,7 @@ void IRFxAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     spec.sampleRate = sampleRate;
     spec.numChannels = getTotalNumOutputChannels();
     
-    outputIsStereo = outputMonoStereoParam->getIndex() == 1;
-    
-    if (deferredIR1File.existsAsFile())
-        loadIR1(deferredIR1File);
-
-    if (deferredIR2File.existsAsFile())
-        loadIR2(deferredIR2File);
+    paramSource.fill(snapshot, true);
     
     irLoader1 = std::make_unique<juce::dsp::Convolution>();
     irLoader2 = std::make_unique<juce::dsp::Convolution>();
@@ -363,15 +201,25 @@ void IRFxAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     irLoader2->reset();
     irLoader1->prepare(spec);
     irLoader2->prepare(spec);
+    irHandOver->reset();
     
-    spec.numChannels = getTotalNumOutputChannels();
-    inputGain.prepare(spec);
-    inputGain.setRampDurationSeconds(0.05);
-    outputGain.prepare(spec);
-    outputGain.setRampDurationSeconds(0.05);
+    // Engines are rebuilt for every new spec, so each IR is loaded again. Offline bounces
+    // build them here so the render starts wet; otherwise they come from the shared pool.
+    // Only a session restore holds the output for them, not every re-prepare.
+    for (int irIndex = 1; irIndex <= 2; ++irIndex)
+    {
+        if (isNonRealtime())
+            buildIRNow(irIndex);
+        else
+            restoreIR(irIndex, restoreDeferred);
+    }
+    restoreDeferred = false;
     
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
+    spec.numChannels = getTotalNumOutputChannels();
+    gainPlan.prepare(spec, 0.05);
+    for (auto& crossfade : irCrossfades)
+        crossfade.prepare(spec);
+    irTempBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
     
     juce::dsp::ProcessSpec monoSpec = spec;
     monoSpec.numChannels = 1;  // IMPORTANT: mono
@@ -388,77 +236,49 @@ void IRFxAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     
     delayInstance.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
     
-    for(auto smoother : getSmoothers())
-        smoother->reset(sampleRate, 0.05);
+    std::array<float, Params::numSmoothed> rampSeconds {};
+    for (size_t i = 0; i < rampSeconds.size(); ++i)
+        rampSeconds[i] = Params::getSpec(Params::smoothedParams[i]).smoothingSeconds;
+    smoothers.reset(sampleRate, rampSeconds);
     
     updateSmootherFromParams(1, SmootherUpdateMode::initialize);
     updateParams();
+    
+    // A filter resizes its state the first time it sees a new filter order; get that
+    // done here now that the real coefficients are in, not on the first audio block
+    for (auto& chain : irEQMonoChainArray)
+        chain.reset();
+    for (auto& chain : toneStackMonoChainAray)
+        chain.reset();
+    
+    bypassManager.prepare(spec);
+    updateBypassStates(true);
+    restoreGate.prepare(spec, 0.05);
+    
+    spectrumAnalyzer.prepare(sampleRate);
 }
 
 void IRFxAudioProcessor::updateSmootherFromParams(int numSamplesToSkip, SmootherUpdateMode init)
 {
-    auto paramsNeedingSmoothing = std::vector
-    {
-        lowCutFreqParam,
-        highCutFreqParam,
-        ir1LevelParam,
-        ir2LevelParam,
-        ir1PanParam,
-        ir2PanParam,
-        lowEQGainParam,
-        midEQGainParam,
-        midEQFreqParam,
-        highEQGainParam,
-        saturationDriveParam,
-        saturationMixParam,
-        delayMixParam,
-        delayFeedbackParam,
-        delayTimeParam,
-        inputGainParam,
-        outputGainParam,
-    };
-    
-    auto smoothers = getSmoothers();
-    jassert(smoothers.size() == paramsNeedingSmoothing.size());
-    
-    for (size_t i = 0; i < smoothers.size(); ++i)
+    const float morphSeconds = presetSwitcher.getMorphSeconds();
+    
+    for (size_t i = 0; i < Params::smoothedParams.size(); ++i)
     {
-        auto smoother = smoothers[i];
-        auto param = paramsNeedingSmoothing [i];
+        const float target = snapshot.get(Params::smoothedParams[i]);
         
         if (init == SmootherUpdateMode::initialize)
-            smoother->setCurrentAndTargetValue(param->get());
+            smoothers.setCurrentAndTargetValue(i, target);
+        else if (init == SmootherUpdateMode::morph)
+        {
+            // Never faster than the parameter's own smoothing
+            const float seconds = juce::jmax(morphSeconds, Params::getSpec(Params::smoothedParams[i]).smoothingSeconds);
+            smoothers.setTargetValue(i, target, static_cast<int>(seconds * spec.sampleRate));
+        }
         else
-            smoother->setTargetValue(param->get());
-        
-        smoother->skip(numSamplesToSkip);
+            smoothers.setTargetValue(i, target);
     }
-}
-
-std::vector<juce::SmoothedValue<float>*> IRFxAudioProcessor::getSmoothers()
-{
-    auto smoothers = std::vector
-    {
-        &lowCutFreqParamSmoother,
-        &highCutFreqParamSmoother,
-        &ir1LevelParamSmoother,
-        &ir2LevelParamSmoother,
-        &ir1PanParamSmoother,
-        &ir2PanParamSmoother,
-        &lowEQGainParamSmoother,
-        &midEQGainParamSmoother,
-        &midEQFreqParamSmoother,
-        &highEQGainParamSmoother,
-        &saturationDriveParamSmoother,
-        &saturationMixParamSmoother,
-        &delayMixParamSmoother,
-        &delayFeedbackParamSmoother,
-        &delayTimeParamSmoother,
-        &inputGainParamSmoother,
-        &outputGainParamSmoother,
-    };
-    
-    return smoothers;
+    
+    smoothers.skip(numSamplesToSkip);
 }
 
 void IRFxAudioProcessor::releaseResources()
@@ -486,30 +306,18 @@ void IRFxAudioProcessor::loadIR1(const juce::File &irFile)
 {
     // Store the file path for later use
     apvts.state.setProperty("IR1FilePath", irFile.getFullPathName(), nullptr);
+    embeddedIRs[0] = nullptr;
+    const int generation = irHandOver->beginRequest(1, false);
     
     if (!irFile.existsAsFile())
         return;
 
+    // Not prepared yet: prepareToPlay picks the stored path up
     if (spec.sampleRate == 0)
-    {
-        deferredIR1File = irFile;
         return;
-    }
 
-    
-    auto newIR = std::make_unique<juce::dsp::Convolution>();
-    newIR->loadImpulseResponse(irFile,
-                               juce::dsp::Convolution::Stereo::yes,
-                               juce::dsp::Convolution::Trim::yes,
-                               0,
-                               juce::dsp::Convolution::Normalise::yes);
-    
-    // Prepare it here with the cached spec
-    newIR->prepare(spec);
-    
-    pendingIR1 = std::move(newIR);
-    ir1PendingUpdate.store(true);
-    isIR1Loaded = true;
+    if (loadIRProgressively(1, generation, irFile))
+        setIRLoaded(1, true);
 }
 
 
@@ -517,280 +325,552 @@ void IRFxAudioProcessor::loadIR2(const juce::File& irFile)
 {
     // Store the file path for later use
     apvts.state.setProperty("IR2FilePath", irFile.getFullPathName(), nullptr);
+    embeddedIRs[1] = nullptr;
+    const int generation = irHandOver->beginRequest(2, false);
     
     if (!irFile.existsAsFile())
         return;
 
+    // Not prepared yet: prepareToPlay picks the stored path up
     if (spec.sampleRate == 0)
-    {
-        deferredIR2File = irFile;
         return;
-    }
     
-    auto newIR = std::make_unique<juce::dsp::Convolution>();
-    newIR->loadImpulseResponse(irFile,
-                               juce::dsp::Convolution::Stereo::yes,
-                               juce::dsp::Convolution::Trim::yes,
-                               0,
-                               juce::dsp::Convolution::Normalise::yes);
+    if (loadIRProgressively(2, generation, irFile))
+        setIRLoaded(2, true);
+}
 
-    newIR->prepare(spec);
+bool IRFxAudioProcessor::loadIRProgressively(int irIndex, int generation, const juce::File& irFile)
+{
+    // Read through the cache: mapped, trimmed, and shared with every other instance
+    const auto audio = irCache->load({ nullptr, irFile });
+    if (audio == nullptr)
+        return false;
+
+    // Short (cab) IRs: the full engine is as quick to prepare as a preview would be.
+    // Offline renders wait for the real thing rather than print the preview.
+    const auto previewLength = static_cast<int>(audio->sampleRate * previewSeconds);
+    if (audio->buffer.getNumSamples() <= 2 * previewLength || isNonRealtime())
+    {
+        irHandOver->offer(irIndex, generation, IRRestorePool::makeEngine(*audio, spec));
+        return true;
+    }
 
-    pendingIR2 = std::move(newIR);
-    ir2PendingUpdate.store(true);
-    isIR2Loaded = true;
+    // Long IRs: the head sounds right away, the full engine follows from the pool and is
+    // crossfaded in under the same request. A newer load drops it, queued or finished.
+    irHandOver->offer(irIndex, generation, IRRestorePool::makePreviewEngine(*audio, previewLength, spec));
+    irRestorePool->restore(irHandOver, irIndex, generation, { nullptr, irFile }, spec);
+    return true;
 }
 
 
 
-float computeRMS(const float* data, size_t numSamples)
+void IRFxAudioProcessor::unloadIR(int irIndex)
 {
-    float sumSquares = 0.0f;
-    for (size_t i = 0; i < numSamples; ++i)
-        sumSquares += data[i] * data[i];
-
-    return std::sqrt(sumSquares / (float)numSamples);
+    // The engines in use belong to the audio thread: the slot gets a silent engine through the
+    // hand-over and fades out to it there. Not prepared: nothing is playing, nothing to fade.
+    const int generation = irHandOver->beginRequest(irIndex, false);
+    if (spec.sampleRate != 0)
+        irHandOver->offerUnload(irIndex, generation, IRRestorePool::makeSilentEngine(spec), commitInProgress);
+
+    setIRLoaded(irIndex, false);
+    apvts.state.removeProperty(irIndex == 1 ? "IR1FilePath" : "IR2FilePath", nullptr);
+    embeddedIRs[static_cast<size_t>(irIndex - 1)] = nullptr;
 }
 
+IRRestorePool::Source IRFxAudioProcessor::getIRSource(int irIndex) const
+{
+    // The audio the session carried if there is any, otherwise the stored path
+    return { embeddedIRs[static_cast<size_t>(irIndex - 1)],
+             juce::File(apvts.state.getProperty(irIndex == 1 ? "IR1FilePath" : "IR2FilePath").toString()) };
+}
 
-bool clipDetection(juce::AudioBuffer<float>& buffer)
+void IRFxAudioProcessor::restoreIR(int irIndex, bool holdOutput)
 {
-    bool isClipping = false;
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    auto source = getIRSource(irIndex);
+    if (spec.sampleRate == 0 || (source.embedded == nullptr && ! source.file.existsAsFile()))
+        return;
+    
+    // Offline there is no deadline to protect: the first rendered block already has the IR
+    if (isNonRealtime())
     {
-        auto* samples = buffer.getReadPointer(channel);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        const int generation = irHandOver->beginRequest(irIndex, false);
+        if (const auto audio = irCache->load(source))
         {
-            auto sampleAbs = std::abs(samples[i]);
-            if (sampleAbs > 1.0f)
-            {
-                isClipping = true;
-                break; // you can also break out of both loops early if you want
-            }
+            irHandOver->offer(irIndex, generation, IRRestorePool::makeEngine(*audio, spec));
+            setIRLoaded(irIndex, true);
         }
+        return;
     }
     
-    return isClipping;
+    const int generation = irHandOver->beginRequest(irIndex, holdOutput);
+    setIRLoaded(irIndex, true);
+    irRestorePool->restore(irHandOver, irIndex, generation, std::move(source), spec);
+}
+
+void IRFxAudioProcessor::buildIRNow(int irIndex)
+{
+    const auto audio = irCache->load(getIRSource(irIndex));
+    if (audio == nullptr)
+        return;
+    
+    // prepareToPlay never runs alongside processBlock, so no hand-over is needed
+    (irIndex == 1 ? irLoader1 : irLoader2) = IRRestorePool::makeEngine(*audio, spec);
+    setIRLoaded(irIndex, true);
+}
+
+void IRFxAudioProcessor::setRestoreOutput(RestoreGate::Mode mode)
+{
+    restoreGate.setMode(mode);
+    apvts.state.setProperty("RestoreOutput", static_cast<int>(mode), nullptr);
+}
+
+void expandMonoInputToStereo(juce::AudioBuffer<float>& buffer, int totalNumInputChannels, int totalNumOutputChannels)
+{
+    // The host's buffer already holds max(inputs, outputs) channels, so there is nothing to resize
+    jassert(totalNumInputChannels != 1 || buffer.getNumChannels() >= totalNumOutputChannels);
+
+    if (totalNumInputChannels == 1 && totalNumOutputChannels == 2 && buffer.getNumChannels() >= 2)
+    {
+        // copy left to right channel
+        buffer.copyFrom(1, 0, buffer.getReadPointer(0), buffer.getNumSamples());
+    }
 }
 
 void IRFxAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    [[maybe_unused]] int totalNumInputChannels  = getTotalNumInputChannels();
-    [[maybe_unused]] int totalNumOutputChannels = getTotalNumOutputChannels();
+    watchdog.blockStarted();
+   #if IRFX_ENABLE_PROFILING
+    profiler.beginBlock();
+   #endif
+    // Own scope: the whole-block time is recorded when it closes, before the watchdog reads it
+    {
+        IRFX_PROFILE_STAGE(profiler, wholeBlock);
+        tracer.begin(TraceRecorder::Event::processBlock);
+        [[maybe_unused]] int totalNumInputChannels  = getTotalNumInputChannels();
+        [[maybe_unused]] int totalNumOutputChannels = getTotalNumOutputChannels();
 
+        if (buffer.getNumSamples() > static_cast<int>(spec.maximumBlockSize))
+            tracer.instant(TraceRecorder::Event::oversizedBlock, static_cast<float>(buffer.getNumSamples()));
+        traceTransport();
 
-    if (totalNumInputChannels == 1 && totalNumOutputChannels == 2)
-    {
-        const int numSamples = buffer.getNumSamples();
-        buffer.setSize(2, numSamples, true, true, true); // expand to stereo, keep content
+        expandMonoInputToStereo(buffer, totalNumInputChannels, totalNumOutputChannels);
 
-        // copy left to right channel
-        buffer.copyFrom(1, 0, buffer.getReadPointer(0), numSamples);
+        // Blocks over the prepared size run in prepared-size pieces, so no scratch buffer ever has to grow
+        const int maxSegment = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
+        for (int start = 0; start < buffer.getNumSamples(); start += maxSegment)
+        {
+            juce::AudioBuffer<float> segment(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start,
+                                             juce::jmin(maxSegment, buffer.getNumSamples() - start));
+            processSegment(segment);
+        }
+
+        tracer.end(TraceRecorder::Event::processBlock);
     }
 
+    // Offline renders have no deadline, so they are never reported
+    if (isNonRealtime())
+        return;
+
+   #if IRFX_ENABLE_PROFILING
+    const auto* stageTicks = &profiler.getBlockTicks();
+   #else
+    const std::array<juce::int64, Profiling::numStages>* stageTicks = nullptr;
+   #endif
 
+    // Went over the time the host gave us for this block: keep the evidence
+    if (const float load = watchdog.blockFinished(buffer.getNumSamples(), spec.sampleRate, snapshot, stageTicks); load >= 1.f)
+    {
+        tracer.instant(TraceRecorder::Event::deadlineOverrun, load);
+        tracer.requestDump("overrun");
+    }
+}
 
-    //========================                    ========================
-        
-    updateSmootherFromParams(buffer.getNumSamples(), SmootherUpdateMode::liveInRealTime);
+void IRFxAudioProcessor::processSegment(juce::AudioBuffer<float>& buffer)
+{
+    presetBlock = presetSwitcher.beginBlock();
+    paramSource.fill(snapshot);
+    updateSmootherFromParams(buffer.getNumSamples(), presetBlock.morph ? SmootherUpdateMode::morph : SmootherUpdateMode::liveInRealTime);
     updateParams();
+    updateBypassStates(false);
+    meterBus.beginBlock(buffer.getNumSamples());
+    
+    // After a session load, hold the output back until the IRs in use have arrived
+    const bool irsInUse = ! bypassManager.isFullyBypassed(BypassManager::plugin) && ! bypassManager.isFullyBypassed(BypassManager::irLoader);
+    const bool waitingForIR = irsInUse && ((snapshot.ir1Loaded && ! snapshot.ir1Muted && irHandOver->isRestoring(1))
+                                        || (snapshot.ir2Loaded && ! snapshot.ir2Muted && irHandOver->isRestoring(2)));
+    restoreGate.begin(buffer, waitingForIR);
+    
+    bypassManager.process(BypassManager::plugin, buffer,
+                          [this] { resetModuleState(); },
+                          [this, &buffer] { processChain(buffer); });
     
-    if (pluginBypassParam->get() == false)
+    restoreGate.end(buffer);
+    meterBus.publish();
+}
+
+void IRFxAudioProcessor::applyPendingIR(int irIndex)
+{
+    // The last swap is still fading: the engine waits
+    auto& crossfade = irCrossfades[static_cast<size_t>(irIndex - 1)];
+    if (crossfade.isFading())
+        return;
+    
+    // Done fading out to an unload's silence: the slot drops out from the next block on
+    irHandOver->finishUnload(irIndex);
+    
+    // Engines of a commit that hasn't finished by this block's start wait for the next one
+    if (irHandOver->takeIfReady(irIndex, presetBlock.commitsFinished, irIndex == 1 ? irLoader1 : irLoader2, crossfade.replaced))
     {
-        outputIsStereo = outputMonoStereoParam->getIndex() == 1;
-        //========================    IN GAIN part    ========================
-        inputGain.setGainDecibels(inputGainParamSmoother.getCurrentValue());
-        applyGain(buffer, inputGain);
-        
-        //========================    IR LOADER part    ========================
-        if (irLoaderBypassParam->get() == false)
-        {
-            
-            // Evaluate effective loading states after mute
-            const bool useIR1 = isIR1Loaded && !isIR1Muted;
-            const bool useIR2 = isIR2Loaded && !isIR2Muted;
+        const float fadeSeconds = presetBlock.morph ? juce::jmax(0.02f, presetSwitcher.getMorphSeconds()) : 0.05f;
+        crossfade.start(static_cast<int>(fadeSeconds * spec.sampleRate));
+        tracer.instant(TraceRecorder::Event::irSwap, static_cast<float>(irIndex));
+    }
+}
 
-            if (useIR1 && useIR2)
-            {
-                if (ir1PendingUpdate.exchange(false))
-                    irLoader1 = std::move(pendingIR1);
-                if (ir2PendingUpdate.exchange(false))
-                    irLoader2 = std::move(pendingIR2);
-                
-                juce::AudioBuffer<float> tempBuffer;
-                tempBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples());
-                tempBuffer.makeCopyOf(buffer, true);
-                
-                buffer.applyGain(juce::Decibels::decibelsToGain(ir1LevelParamSmoother.getCurrentValue()));
-                tempBuffer.applyGain(juce::Decibels::decibelsToGain(ir2LevelParamSmoother.getCurrentValue()));
-                juce::dsp::AudioBlock<float> block1(buffer);
-                juce::dsp::AudioBlock<float> block2(tempBuffer);
-                irLoader1->process(juce::dsp::ProcessContextReplacing<float>(block1));
-                irLoader2->process(juce::dsp::ProcessContextReplacing<float>(block2));
-                
-                if (outputIsStereo)
-                {
-                    applyEqualPowerPan(buffer, ir1PanParamSmoother.getCurrentValue() * 0.01f);
-                    applyEqualPowerPan(tempBuffer, ir2PanParamSmoother.getCurrentValue() * 0.01f);
-                }
-                else
-                {
-                    applyEqualPowerPan(buffer, 0.f);
-                    applyEqualPowerPan(tempBuffer, 0.f);
-                }
+void IRFxAudioProcessor::traceTransport()
+{
+    if (! tracer.isEnabled())
+        return;
 
-                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-                    buffer.addFrom(ch, 0, tempBuffer, ch, 0, buffer.getNumSamples());
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return;
 
-                buffer.applyGain(juce::Decibels::decibelsToGain(3.f));
-            }
-            else if (useIR1)
+    const auto position = playHead->getPosition();
+    if (! position.hasValue())
+        return;
+
+    if (const int playing = position->getIsPlaying() ? 1 : 0; playing != lastTracedPlaying)
+    {
+        lastTracedPlaying = playing;
+        tracer.instant(TraceRecorder::Event::transport, static_cast<float>(playing));
+    }
+
+    if (const auto bpm = position->getBpm(); bpm.hasValue() && ! juce::approximatelyEqual(*bpm, lastTracedBpm))
+    {
+        lastTracedBpm = *bpm;
+        tracer.instant(TraceRecorder::Event::tempo, static_cast<float>(*bpm));
+    }
+}
+
+void IRFxAudioProcessor::processChain (juce::AudioBuffer<float>& buffer)
+{
+    const bool outputIsStereo = snapshot.getIndex(Params::outputMonoStereo) == 1;
+    //========================    IN GAIN part    ========================
+    gainPlan.setTargets(getSmoothedValue(Params::inGain), getSmoothedValue(Params::outGain));
+    
+    // The input gain may be fused into the IR pass, so the input is read before it and scaled
+    meterBus.measure(MeterBus::input, buffer, gainPlan.getInputGainTarget());
+    spectrumAnalyzer.push(SpectrumAnalyzer::pre, buffer, gainPlan.getInputGainTarget());
+    
+    // The input gain rides along with the IR level multiply in front of the convolvers.
+    // While the stage is fading its dry path needs the input gain on its own.
+    const bool fuseInputGain = bypassManager.isFullyActive(BypassManager::irLoader);
+    if (! fuseInputGain)
+    {
+        IRFX_PROFILE_STAGE(profiler, inputGain);
+        gainPlan.applyInput(buffer);
+    }
+    
+    //========================    IR LOADER part    ========================
+    bool irOutputSilenced = false;
+    
+    bypassManager.process(BypassManager::irLoader, buffer,
+                          [this]
+    {
+        irLoader1->reset();
+        irLoader2->reset();
+        for (auto& crossfade : irCrossfades)
+            crossfade.reset();
+        for (auto& chain : irEQMonoChainArray)
+            chain.reset();
+    },
+                          [this, &buffer, &irOutputSilenced, outputIsStereo, fuseInputGain]
+    {
+        // Evaluate effective loading states after mute; an unloaded slot runs until it has faded out
+        const bool useIR1 = (snapshot.ir1Loaded || irHandOver->isUnloading(1)) && !snapshot.ir1Muted;
+        const bool useIR2 = (snapshot.ir2Loaded || irHandOver->isUnloading(2)) && !snapshot.ir2Muted;
+        
+        // Level goes in before convolution with the input gain; pan and makeup after it, as they always did
+        const float ir1Pan = outputIsStereo ? getSmoothedValue(Params::ir1Pan) * 0.01f : 0.f;
+        const float ir2Pan = outputIsStereo ? getSmoothedValue(Params::ir2Pan) * 0.01f : 0.f;
+
+        if (useIR1 && useIR2)
+        {
+            applyPendingIR(1);
+            applyPendingIR(2);
+            
+            const auto ir1Gains = GainPlan::makeBranchGains(getSmoothedValue(Params::ir1Level), ir1Pan, 3.f);
+            const auto ir2Gains = GainPlan::makeBranchGains(getSmoothedValue(Params::ir2Level), ir2Pan, 3.f);
+            
+            irTempBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
             {
-                if (ir1PendingUpdate.exchange(false))
-                    irLoader1 = std::move(pendingIR1);
-                buffer.applyGain(juce::Decibels::decibelsToGain(ir1LevelParamSmoother.getCurrentValue()));
-                juce::dsp::AudioBlock<float> block(buffer);
-                irLoader1->process(juce::dsp::ProcessContextReplacing<float>(block));
-                
-                if (outputIsStereo)
-                {
-                    applyEqualPowerPan(buffer, ir1PanParamSmoother.getCurrentValue() * 0.01f);
-                }
-                else
-                {
-                    applyEqualPowerPan(buffer, 0.f);
-                }
-                
-                buffer.applyGain(juce::Decibels::decibelsToGain(9.f));
+                IRFX_PROFILE_STAGE(profiler, inputGain);
+                gainPlan.applyInputAndSplit(buffer, irTempBuffer, ir1Gains, ir2Gains, fuseInputGain);
             }
-            else if (useIR2)
+            
             {
-                if (ir2PendingUpdate.exchange(false))
-                    irLoader2 = std::move(pendingIR2);
-                buffer.applyGain(juce::Decibels::decibelsToGain(ir2LevelParamSmoother.getCurrentValue()));
-                juce::dsp::AudioBlock<float> block(buffer);
-                irLoader2->process(juce::dsp::ProcessContextReplacing<float>(block));
-                
-                if (outputIsStereo)
-                {
-                    applyEqualPowerPan(buffer, ir2PanParamSmoother.getCurrentValue() * 0.01f);
-                }
-                else
-                {
-                    applyEqualPowerPan(buffer, 0.f);
-                }
-
-                buffer.applyGain(juce::Decibels::decibelsToGain(9.f));
+                IRFX_PROFILE_STAGE(profiler, ir1);
+                irCrossfades[0].process(*irLoader1, buffer);
             }
-            else if (isIR1Muted && isIR2Muted)
             {
-                buffer.applyGain(juce::Decibels::decibelsToGain(-100.f));
-                return;
+                IRFX_PROFILE_STAGE(profiler, ir2);
+                irCrossfades[1].process(*irLoader2, irTempBuffer);
             }
 
-
-            // Apply EQ to final buffer
-            juce::dsp::AudioBlock<float> eqBlock(buffer);
-            
-            for (int ch {0}; ch < buffer.getNumChannels(); ++ch)
+            GainPlan::mixBranchOutputs(buffer, irTempBuffer, ir1Gains, ir2Gains);
+        }
+        else if (useIR1)
+        {
+            applyPendingIR(1);
+            const auto ir1Gains = GainPlan::makeBranchGains(getSmoothedValue(Params::ir1Level), ir1Pan, 9.f);
             {
-                auto eqBlockCh = eqBlock.getSingleChannelBlock(ch);
-                juce::dsp::ProcessContextReplacing<float> eqContextCh(eqBlockCh);
-                irEQMonoChainArray[ch].process(eqContextCh);
+                IRFX_PROFILE_STAGE(profiler, inputGain);
+                gainPlan.applyInputAndBranch(buffer, ir1Gains, fuseInputGain);
             }
+            IRFX_PROFILE_STAGE(profiler, ir1);
+            irCrossfades[0].process(*irLoader1, buffer);
+            GainPlan::applyBranchOutput(buffer, ir1Gains);
         }
-        
-        
-        //========================    TONE STACK part    ========================
-        if (eqBypassParam->get() == false)
+        else if (useIR2)
         {
-            juce::dsp::AudioBlock<float> toneStackBlock(buffer);
-
-            for (int ch {0}; ch < buffer.getNumChannels(); ++ch)
+            applyPendingIR(2);
+            const auto ir2Gains = GainPlan::makeBranchGains(getSmoothedValue(Params::ir2Level), ir2Pan, 9.f);
             {
-                auto toneBlock = toneStackBlock.getSingleChannelBlock(ch);
-                juce::dsp::ProcessContextReplacing<float> context(toneBlock);
-                toneStackMonoChainAray[ch].process(context);
+                IRFX_PROFILE_STAGE(profiler, inputGain);
+                gainPlan.applyInputAndBranch(buffer, ir2Gains, fuseInputGain);
             }
+            IRFX_PROFILE_STAGE(profiler, ir2);
+            irCrossfades[1].process(*irLoader2, buffer);
+            GainPlan::applyBranchOutput(buffer, ir2Gains);
         }
-        
-        //========================    SATURATION part    ========================
-        
-        auto drive = saturationDriveParamSmoother.getCurrentValue();
-
-        if (!saturationBypassParam->get() && drive > 0.f)
+        else if (snapshot.ir1Muted && snapshot.ir2Muted)
         {
-            float mix = (saturationMixParamSmoother.getCurrentValue()) * 0.01f;
-            saturationInstance.processBlock(buffer, drive, saturationModeParam->getIndex(), mix);
+            // -100 dB is silence as far as juce::Decibels is concerned
+            gainPlan.applyInputAndBranch(buffer, GainPlan::makeBranchGains(-100.f, 0.f, 0.f), fuseInputGain);
+            irOutputSilenced = true;
+            return;
         }
+        else if (fuseInputGain)
+        {
+            IRFX_PROFILE_STAGE(profiler, inputGain);
+            gainPlan.applyInput(buffer);
+        }
+
 
+        // Apply EQ to final buffer
+        IRFX_PROFILE_STAGE(profiler, irEQ);
+        juce::dsp::AudioBlock<float> eqBlock(buffer);
         
-        //========================    DELAY part    ========================
+        for (int ch {0}; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto eqBlockCh = eqBlock.getSingleChannelBlock(ch);
+            juce::dsp::ProcessContextReplacing<float> eqContextCh(eqBlockCh);
+            irEQMonoChainArray[ch].process(eqContextCh);
+        }
+    });
+    
+    if (irOutputSilenced)
+        return;
+    
+    meterBus.measure(MeterBus::postIR, buffer);
+    
+    //========================    TONE STACK part    ========================
+    bypassManager.process(BypassManager::toneStack, buffer,
+                          [this]
+    {
+        for (auto& chain : toneStackMonoChainAray)
+            chain.reset();
+    },
+                          [this, &buffer]
+    {
+        IRFX_PROFILE_STAGE(profiler, toneStack);
+        juce::dsp::AudioBlock<float> toneStackBlock(buffer);
 
-        if (!delayBypassParam->get())
+        for (int ch {0}; ch < buffer.getNumChannels(); ++ch)
         {
-            bool delayIsMono = !outputIsStereo;
-            delayInstance.setFeedback(delayFeedbackParamSmoother.getCurrentValue());
-            delayInstance.setMix(delayMixParamSmoother.getCurrentValue());
-            using Mode = DelayProcessor::Mode;
-            delayInstance.setMode(delayModeParam->getIndex() == 0 ? Mode::Digital : Mode::Tape);
-            bool isSync = delaySyncParam->get();
-            delayInstance.setSyncEnabled(isSync);
-            if (isSync)
-                delayInstance.setSubdivision(delayNoteParam->getIndex());
-            else
-                delayInstance.setDelayTime(delayTimeParamSmoother.getCurrentValue());
-            delayInstance.setHostBpm(getPlayHead()->getPosition()->getBpm().orFallback(120.0));
-            delayInstance.process(buffer, buffer.getNumSamples(), delayIsMono);
+            auto toneBlock = toneStackBlock.getSingleChannelBlock(ch);
+            juce::dsp::ProcessContextReplacing<float> context(toneBlock);
+            toneStackMonoChainAray[ch].process(context);
         }
+    });
+    
+    meterBus.measure(MeterBus::postEQ, buffer);
+    
+    //========================    SATURATION part    ========================
+    bypassManager.process(BypassManager::saturation, buffer,
+                          [this] { saturationInstance.reset(); },
+                          [this, &buffer]
+    {
+        IRFX_PROFILE_STAGE(profiler, saturation);
+        auto drive = getSmoothedValue(Params::distDrive);
+        float mix = (getSmoothedValue(Params::distMix)) * 0.01f;
+        saturationInstance.processBlock(buffer, drive, snapshot.getIndex(Params::distMode), mix);
+    });
+    
+    meterBus.measure(MeterBus::postSaturation, buffer);
+    
+    //========================    DELAY part    ========================
+    bypassManager.process(BypassManager::delay, buffer,
+                          [this] { delayInstance.reset(); },
+                          [this, &buffer, outputIsStereo]
+    {
+        IRFX_PROFILE_STAGE(profiler, delay);
+        bool delayIsMono = !outputIsStereo;
+        delayInstance.setFeedback(getSmoothedValue(Params::delayFeedback));
+        delayInstance.setMix(getSmoothedValue(Params::delayMix));
+        using Mode = DelayProcessor::Mode;
+        delayInstance.setMode(snapshot.getIndex(Params::delayMode) == 0 ? Mode::Digital : Mode::Tape);
+        bool isSync = snapshot.getBool(Params::delaySync);
+        delayInstance.setSyncEnabled(isSync);
+        if (isSync)
+            delayInstance.setSubdivision(snapshot.getIndex(Params::delayNote));
+        else
+            delayInstance.setDelayTime(getSmoothedValue(Params::delayTime));
+        double hostBpm = 120.0;
+        if (auto* playHead = getPlayHead())
+            if (const auto position = playHead->getPosition())
+                hostBpm = position->getBpm().orFallback(hostBpm);
+        delayInstance.setHostBpm(static_cast<float>(hostBpm));
+        delayInstance.process(buffer, buffer.getNumSamples(), delayIsMono);
+    });
 
 
-        //========================    OUTPUT GAIN part    ========================
-        outputGain.setGainDecibels(outputGainParamSmoother.getCurrentValue());
-        applyGain(buffer, outputGain);
-        
-        //========================    OUTPUT CLIP DETECTION    ========================
-        if (clipDetection(buffer))
-            clipFlagOut.store(true); // atomic flag to be safe for GUI thread
+    //========================    OUTPUT GAIN part    ========================
+    {
+        IRFX_PROFILE_STAGE(profiler, output);
+        gainPlan.applyOutput(buffer);
+    }
+    
+    //========================    OUTPUT METERING    ========================
+    meterBus.measure(MeterBus::output, buffer);
+    spectrumAnalyzer.push(SpectrumAnalyzer::post, buffer);
+}
+
+void IRFxAudioProcessor::updateBypassStates(bool skipRamps)
+{
+    // Zero drive is a bypass too, so it fades instead of jumping into the saturator
+    const bool saturationOff = snapshot.getBool(Params::distBypass) || getSmoothedValue(Params::distDrive) <= 0.f;
+
+    const std::array<std::pair<BypassManager::Module, bool>, BypassManager::numModules> states
+    {{
+        { BypassManager::plugin,     snapshot.getBool(Params::pluginBypass) },
+        { BypassManager::irLoader,   snapshot.getBool(Params::irBypass) },
+        { BypassManager::toneStack,  snapshot.getBool(Params::eqBypass) },
+        { BypassManager::saturation, saturationOff },
+        { BypassManager::delay,      snapshot.getBool(Params::delayBypass) },
+    }};
+
+    for (auto [module, bypassed] : states)
+    {
+        if (skipRamps)
+            bypassManager.snapTo(module, bypassed);
+        else
+            bypassManager.setBypassed(module, bypassed);
     }
 }
 
+void IRFxAudioProcessor::resetModuleState()
+{
+    irLoader1->reset();
+    irLoader2->reset();
+    for (auto& crossfade : irCrossfades)
+        crossfade.reset();
+    for (auto& chain : irEQMonoChainArray)
+        chain.reset();
+    for (auto& chain : toneStackMonoChainAray)
+        chain.reset();
+    saturationInstance.reset();
+    delayInstance.reset();
+    gainPlan.reset();
+}
+
+void IRFxAudioProcessor::reset()
+{
+    // Hosts (auval among them) may call this before prepareToPlay, when there are no engines yet
+    if (spec.sampleRate == 0 || irLoader1 == nullptr || irLoader2 == nullptr)
+        return;
+    
+    // Clears tails (convolution history, filters, delay line) but keeps the loaded IRs
+    resetModuleState();
+    restoreGate.reset();
+}
+
+void IRFxAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    juce::ScopedNoDenormals noDenormals;
+    expandMonoInputToStereo(buffer, getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    // Host bypass: the chain restarts from a clean state and fades back in
+    bypassManager.snapTo(BypassManager::plugin, true);
+
+    // The chain reports no latency (Convolution runs zero-latency), so the dry signal is already aligned
+}
+
 //==============================================================================
 bool IRFxAudioProcessor::hasEditor() const
 {
-    return true; // (change this to false if you choose to not supply an editor)
+    return ! IRFX_HEADLESS;
 }
 
 juce::AudioProcessorEditor* IRFxAudioProcessor::createEditor()
 {
+   #if IRFX_HEADLESS
+    return nullptr;
+   #else
     return new IRFxAudioProcessorEditor (*this);
+   #endif
 }
 
 //==============================================================================
 void IRFxAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    state.setProperty("CurrentPresetName", currentPresetName, nullptr);
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Hosts ask for this constantly (autosave, undo snapshots), mostly with nothing changed
+    const juce::ScopedLock sl (stateCacheLock);
+    
+    if (stateTracker.consumeChange() || cachedState.isEmpty())
+    {
+        auto state = apvts.copyState();
+        state.setProperty("CurrentPresetName", currentPresetName, nullptr);
+        
+        if (const auto mode = getIREmbedMode(); mode != IRArchive::Mode::off)
+        {
+            // Audio restored from a session is kept as it came, even if the file isn't on this machine
+            IRArchive::SlotEntries slots = embeddedIRs;
+            for (size_t slot = 0; slot < slots.size(); ++slot)
+                if (slots[slot] == nullptr && isIRLoaded(static_cast<int>(slot) + 1))
+                    slots[slot] = irArchive.encode(juce::File(state.getProperty(slot == 0 ? "IR1FilePath" : "IR2FilePath").toString()), mode);
+            
+            IRArchive::write(state, slots);
+        }
+        
+        StateCodec::write(state, cachedState);
+    }
+    
+    destData = cachedState;
 }
 
 
 void IRFxAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xml (getXmlFromBinary(data, sizeInBytes));
-    if (xml && xml->hasTagName(apvts.state.getType()))
+    // Current binary format, or the XML earlier versions wrote
+    juce::ValueTree state = StateCodec::read(data, sizeInBytes, apvts.state.getType());
+    if (state.isValid())
     {
-        juce::ValueTree state = juce::ValueTree::fromXml(*xml);
+        // The session wins over a preset switch that hasn't committed yet
+        presetSwitcher.cancel();
+        embeddedIRs = IRArchive::read(state);
         apvts.replaceState(state);
 
-        // Just cache file path, don't try to load yet!
-        if (auto* ir1Path = apvts.state.getPropertyPointer("IR1FilePath"))
-            deferredIR1File = juce::File(*ir1Path);
-        
-        if (auto* ir2Path = apvts.state.getPropertyPointer("IR2FilePath"))
-            deferredIR2File = juce::File(*ir2Path);
+        restoreGate.setMode(static_cast<RestoreGate::Mode>(static_cast<int>(state.getProperty("RestoreOutput", 0)) == 1 ? 1 : 0));
+        presetSwitcher.setMorphSeconds(static_cast<float>(state.getProperty("PresetMorphSeconds", presetSwitcher.getMorphSeconds())));
+
+        // Parsing is done; the IRs load on the shared pool. Not prepared yet: prepareToPlay
+        // queues them, still holding the output since this is a session restore.
+        restoreDeferred = spec.sampleRate == 0;
+        for (int irIndex = 1; irIndex <= 2; ++irIndex)
+            restoreIR(irIndex, true);
         
         if (auto* presetNameProp = state.getPropertyPointer("CurrentPresetName"))
             currentPresetName = presetNameProp->toString(); // restore preset name
@@ -807,14 +887,123 @@ void IRFxAudioProcessor::savePreset(const juce::File& file)
 void IRFxAudioProcessor::loadPreset(const juce::File& file)
 {
     std::unique_ptr<juce::XmlElement> xml (juce::XmlDocument::parse(file));
-    if (xml && xml->hasTagName(apvts.state.getType()))
+    if (xml)
+        applyPreset(juce::ValueTree::fromXml(*xml));
+}
+
+void IRFxAudioProcessor::applyPreset(const juce::ValueTree& presetState)
+{
+    if (! presetState.hasType(apvts.state.getType()))
+        return;
+    
+    // The library shares its parsed state between instances, so it is never modified
+    auto transaction = std::make_shared<PresetSwitcher::Transaction>();
+    transaction->state = presetState.createCopy();
+    transaction->embedded = IRArchive::read(transaction->state);
+    transaction->spec = spec;
+    
+    for (int irIndex = 1; irIndex <= 2; ++irIndex)
     {
-        juce::ValueTree state = juce::ValueTree::fromXml(*xml);
-        if (auto* presetNameProp = state.getPropertyPointer("CurrentPresetName"))
-            currentPresetName = presetNameProp->toString(); // restore preset name
-        apvts.replaceState(state);
-        updateParams();
+        const auto slot = static_cast<size_t>(irIndex - 1);
+        IRRestorePool::Source source { transaction->embedded[slot],
+                                       juce::File(transaction->state.getProperty(irIndex == 1 ? "IR1FilePath" : "IR2FilePath").toString()) };
+        
+        // Same IR as now: the engine in use stays, no reload and no crossfade
+        const bool sameIR = source.embedded != nullptr
+            ? embeddedIRs[slot] != nullptr && embeddedIRs[slot]->hash == source.embedded->hash
+            : embeddedIRs[slot] == nullptr && source.file == juce::File(apvts.state.getProperty(irIndex == 1 ? "IR1FilePath" : "IR2FilePath").toString());
+        
+        if (source.embedded == nullptr && ! source.file.existsAsFile())
+            transaction->irChanges[slot] = PresetSwitcher::IRChange::unload;
+        else if (! (sameIR && isIRLoaded(irIndex)))
+            transaction->irChanges[slot] = PresetSwitcher::IRChange::load;
+        
+        transaction->irSources[slot] = std::move(source);
+    }
+    
+    // Not prepared: nothing is playing, commit straight away and let prepareToPlay load the IRs
+    if (spec.sampleRate == 0)
+        commitPreset(*transaction);
+    else
+        presetSwitcher.begin(std::move(transaction));
+}
+
+void IRFxAudioProcessor::commitPreset(PresetSwitcher::Transaction& transaction)
+{
+    // prepareToPlay came in between: the staged engines don't fit, load the IRs the usual way
+    const bool specChanged = transaction.spec.sampleRate != spec.sampleRate
+                          || transaction.spec.maximumBlockSize != spec.maximumBlockSize
+                          || transaction.spec.numChannels != spec.numChannels;
+    
+    commitInProgress = presetSwitcher.beginCommit();
+    
+    embeddedIRs = transaction.embedded;
+    if (auto* presetNameProp = transaction.state.getPropertyPointer("CurrentPresetName"))
+        currentPresetName = presetNameProp->toString(); // restore preset name
+    
+    // Instance settings, not part of the sound: they survive the switch
+    const auto embedMode = getIREmbedMode();
+    apvts.replaceState(transaction.state);
+    setIREmbedMode(embedMode);
+    setRestoreOutput(getRestoreOutput());
+    setPresetMorphSeconds(getPresetMorphSeconds());
+    
+    for (int irIndex = 1; irIndex <= 2; ++irIndex)
+    {
+        const auto slot = static_cast<size_t>(irIndex - 1);
+        
+        switch (transaction.irChanges[slot])
+        {
+            case PresetSwitcher::IRChange::keep:
+                break;
+            case PresetSwitcher::IRChange::unload:
+                unloadIR(irIndex);
+                break;
+            case PresetSwitcher::IRChange::load:
+                if (transaction.engines[slot] != nullptr && ! specChanged)
+                {
+                    irHandOver->offer(irIndex, irHandOver->beginRequest(irIndex, false), std::move(transaction.engines[slot]), commitInProgress);
+                    setIRLoaded(irIndex, true);
+                }
+                else if (spec.sampleRate == 0 || specChanged)
+                    restoreIR(irIndex, false);
+                else
+                    unloadIR(irIndex);
+                break;
+        }
+    }
+    
+    stateTracker.markChanged();
+    commitInProgress = 0;
+    presetSwitcher.endCommit();
+}
+
+void IRFxAudioProcessor::prefetchPresetIRs(const std::vector<juce::ValueTree>& presets)
+{
+    std::vector<IRCache::Source> sources;
+    
+    for (const auto& preset : presets)
+    {
+        // IRArchive::read takes the embedded IRs out of the tree it is given
+        auto state = preset.createCopy();
+        const auto embedded = IRArchive::read(state);
+        
+        for (int irIndex = 1; irIndex <= 2; ++irIndex)
+        {
+            IRCache::Source source { embedded[static_cast<size_t>(irIndex - 1)],
+                                     juce::File(state.getProperty(irIndex == 1 ? "IR1FilePath" : "IR2FilePath").toString()) };
+            if (source.isValid())
+                sources.push_back(std::move(source));
+        }
     }
+    
+    irCache->prefetch(sources);
+}
+
+void IRFxAudioProcessor::setPresetMorphSeconds(float seconds)
+{
+    presetSwitcher.setMorphSeconds(seconds);
+    apvts.state.setProperty("PresetMorphSeconds", presetSwitcher.getMorphSeconds(), nullptr);
 }
 
 //==============================================================================
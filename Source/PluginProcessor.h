@@ -9,10 +9,31 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "ParamNames.h"
+
+// Command-line tools build the processor without the editor (createEditor() returns nullptr)
+#ifndef IRFX_HEADLESS
+ #define IRFX_HEADLESS 0
+#endif
+
+#include "ParamRegistry.h"
+#include "ParamSnapshot.h"
 #include "DSP/Saturation.h"
 #include "DSP/DelayProcessor.h"
-#include "DSP/EqualPowerPan.h"
+#include "DSP/GainPlan.h"
+#include "DSP/MeterBus.h"
+#include "DSP/SpectrumAnalyzer.h"
+#include "Utilities/StageProfiler.h"
+#include "Utilities/TraceRecorder.h"
+#include "Utilities/DeadlineWatchdog.h"
+#include "Utilities/IRArchive.h"
+#include "Utilities/StateCodec.h"
+#include "DSP/BypassManager.h"
+#include "DSP/IRHandOver.h"
+#include "DSP/RestoreGate.h"
+#include "Utilities/IRRestorePool.h"
+#include "Utilities/PresetSwitcher.h"
+#include "DSP/IRCrossfade.h"
+#include "DSP/SmootherBank.h"
 
 //==============================================================================
 /**
@@ -33,6 +54,9 @@ class IRFxAudioProcessor  : public juce::AudioProcessor
 #endif
     
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void reset() override;
+    juce::AudioProcessorParameter* getBypassParameter() const override { return cachedParams[Params::pluginBypass]; }
     
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -60,14 +84,44 @@ class IRFxAudioProcessor  : public juce::AudioProcessor
     
     void loadIR1(const juce::File&);
     void loadIR2(const juce::File&);
-    bool isIR1Loaded {false}, isIR2Loaded {false};
-    bool isIR1Muted {false}, isIR2Muted {false};
+    // Fades the slot out, then empties it and forgets its file. irIndex is 1 or 2.
+    void unloadIR(int irIndex);
+    // irIndex is 1 or 2. Safe to call from any thread.
+    bool isIRLoaded(int irIndex) const { return paramSource.isIRLoaded(irIndex); }
+    bool isIRMuted(int irIndex) const { return paramSource.isIRMuted(irIndex); }
+    void setIRLoaded(int irIndex, bool isLoaded) { paramSource.setIRLoaded(irIndex, isLoaded); }
+    void setIRMuted(int irIndex, bool isMuted) { paramSource.setIRMuted(irIndex, isMuted); }
+    
+    // Whether getStateInformation carries the IR audio itself, not just the file paths
+    IRArchive::Mode getIREmbedMode() const { return IRArchive::getMode(apvts.state); }
+    void setIREmbedMode(IRArchive::Mode mode) { IRArchive::setMode(apvts.state, mode); }
+    
+    // What goes out while a session's IRs are still loading: the dry input or silence
+    RestoreGate::Mode getRestoreOutput() const { return restoreGate.getMode(); }
+    void setRestoreOutput(RestoreGate::Mode mode);
+    // True until every IR queued by a session restore or prepareToPlay is in use
+    bool isRestoringIRs() const { return irHandOver->isRestoring(1) || irHandOver->isRestoring(2); }
     
     void updateParams();
     
     void savePreset(const juce::File& file);
     void loadPreset(const juce::File& file);
-    void setCurrentPresetName(const juce::String& name) {currentPresetName = name;}
+    // Applies an already parsed preset (see PresetLibrary). Once prepared, the preset's IRs are
+    // built on the shared pool first and everything switches together, morphing (see PresetSwitcher).
+    void applyPreset(const juce::ValueTree& presetState);
+    // Message thread. Commits a preset switch whose IRs are ready without waiting for the timer;
+    // true while one is still pending. For tools that run no message loop.
+    bool commitPendingPreset() { return presetSwitcher.commitIfReady(); }
+    // Decodes the IRs of presets likely to be switched to next into the shared IRCache,
+    // most likely first; replaces the previous request
+    void prefetchPresetIRs(const std::vector<juce::ValueTree>& presets);
+    // Memory cap of the IRCache, shared by all instances and kept in IRFx's settings file, not the session
+    size_t getIRCacheLimitBytes() const { return irCache->getLimitBytes(); }
+    void setIRCacheLimitBytes(size_t bytes) { irCache->setLimitBytes(bytes); }
+    // How long parameters ramp and IRs crossfade when switching presets
+    float getPresetMorphSeconds() const { return presetSwitcher.getMorphSeconds(); }
+    void setPresetMorphSeconds(float seconds);
+    void setCurrentPresetName(const juce::String& name) {currentPresetName = name; stateTracker.markChanged();}
     juce::String getCurrentPresetName() const {return currentPresetName;}
     
     //==============================================================================
@@ -75,93 +129,73 @@ class IRFxAudioProcessor  : public juce::AudioProcessor
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
     
+    // getStateInformation only re-encodes when this says something changed
+    StateChangeTracker stateTracker {apvts};
+    
+    //======================= PER-BLOCK SNAPSHOT =======================
+    ParamSnapshotSource paramSource {apvts};
+    ParamSnapshot snapshot;
+    
     //======================= PARAMETERS PTRS =======================
-    //IR MODULE
-    juce::AudioParameterFloat* lowCutFreqParam {nullptr};
-    juce::AudioParameterFloat* highCutFreqParam {nullptr};
-    juce::AudioParameterFloat* ir1LevelParam {nullptr};
-    juce::AudioParameterFloat* ir2LevelParam {nullptr};
-    juce::AudioParameterFloat* ir1PanParam {nullptr};
-    juce::AudioParameterFloat* ir2PanParam {nullptr};
-    juce::AudioParameterBool* irLoaderBypassParam {nullptr};
-    //TONE STACK
-    juce::AudioParameterFloat* lowEQGainParam {nullptr};
-    juce::AudioParameterFloat* midEQGainParam {nullptr};
-    juce::AudioParameterFloat* midEQFreqParam {nullptr};
-    juce::AudioParameterFloat* highEQGainParam {nullptr};
-    juce::AudioParameterBool* eqBypassParam {nullptr};
-    //SATURATION
-    juce::AudioParameterFloat* saturationDriveParam {nullptr};
-    juce::AudioParameterFloat* saturationMixParam {nullptr};
-    juce::AudioParameterBool* saturationBypassParam {nullptr};
-    juce::AudioParameterChoice* saturationModeParam {nullptr};
-    //DELAY
-    juce::AudioParameterFloat* delayMixParam {nullptr};
-    juce::AudioParameterFloat* delayFeedbackParam {nullptr};
-    juce::AudioParameterFloat* delayTimeParam {nullptr};
-    juce::AudioParameterChoice* delayModeParam {nullptr};
-    juce::AudioParameterBool* delaySyncParam {nullptr};
-    juce::AudioParameterChoice* delayNoteParam {nullptr};
-    juce::AudioParameterBool* delayBypassParam{nullptr};
-    //IN-OUT GAIN
-    juce::AudioParameterFloat* inputGainParam {nullptr};
-    juce::AudioParameterFloat* outputGainParam {nullptr};
-    //PLUGIN GENERAL PARAMS
-    juce::AudioParameterBool* pluginBypassParam {nullptr};
-    juce::AudioParameterChoice* outputMonoStereoParam {nullptr};
+    // Generated from Params::table, indexed by Params::ID
+    std::array<juce::RangedAudioParameter*, Params::numParams> cachedParams {};
+    
+    template <typename ParamType>
+    ParamType* getParam(Params::ID id) const
+    {
+        auto* param = dynamic_cast<ParamType*>(cachedParams[static_cast<size_t>(id)]);
+        jassert(param != nullptr);
+        return param;
+    }
     
     //======================= SMOOTHED PARAMS =======================
-    juce::SmoothedValue<float>
-    lowCutFreqParamSmoother,
-    highCutFreqParamSmoother,
-    ir1LevelParamSmoother,
-    ir2LevelParamSmoother,
-    ir1PanParamSmoother,
-    ir2PanParamSmoother,
-    lowEQGainParamSmoother,
-    midEQGainParamSmoother,
-    midEQFreqParamSmoother,
-    highEQGainParamSmoother,
-    saturationDriveParamSmoother,
-    saturationMixParamSmoother,
-    delayMixParamSmoother,
-    delayFeedbackParamSmoother,
-    delayTimeParamSmoother,
-    inputGainParamSmoother,
-    outputGainParamSmoother;
+    SmootherBank<Params::numSmoothed> smoothers;
+    
+    float getSmoothedValue(Params::ID id) const
+    {
+        jassert(Params::smootherIndex[static_cast<size_t>(id)] >= 0);
+        return smoothers.getCurrentValue(static_cast<size_t>(Params::smootherIndex[static_cast<size_t>(id)]));
+    }
     //=======================
     
     juce::dsp::ProcessSpec spec;
     std::unique_ptr<juce::dsp::Convolution> irLoader1, irLoader2;
     
-    std::atomic<bool> clipFlagIn { false };
-    std::atomic<bool> clipFlagOut { false };
+    // Per-stage levels for the editor, drained on the message thread
+    MeterBus meterBus;
+    // Chain input vs output spectrum, only fed while the editor's analyzer is showing
+    SpectrumAnalyzer spectrumAnalyzer;
+    
+    // Audio-thread timeline, dumped to Chrome-trace JSON on request
+    TraceRecorder tracer;
     
-    std::atomic<bool> ir1PendingUpdate { false };
-    juce::File irFile1ToLoad;
-    std::unique_ptr<juce::dsp::Convolution> pendingIR1;
-    std::atomic<bool> ir2PendingUpdate { false };
-    juce::File irFile2ToLoad;
-    std::unique_ptr<juce::dsp::Convolution> pendingIR2;
-    juce::File deferredIR1File;
-    juce::File deferredIR2File;
+    // Per-block load against the real-time budget, worst blocks logged off-thread
+    DeadlineWatchdog watchdog;
+    
+   #if IRFX_ENABLE_PROFILING
+    // Per-stage processBlock timings, read by the editor's hidden overlay
+    Profiling::StageProfiler profiler;
+   #endif
+    
+    // Engines on their way to the audio thread, from loadIR1/loadIR2 and session restores
+    std::shared_ptr<IRHandOver> irHandOver = std::make_shared<IRHandOver>();
+    juce::SharedResourcePointer<IRRestorePool> irRestorePool;
+    juce::SharedResourcePointer<IRCache> irCache;
+    
+    // IR audio restored from a session, per slot; used instead of the file until a new IR is loaded
+    IRArchive::SlotEntries embeddedIRs;
+    IRArchive irArchive;
     
     juce::String currentPresetName;
 
 private:
     
-    bool outputIsStereo {false};
 //    float inputLevelL{0.f}, inputLevelR {0.f}, outputLevelL{0.f}, outputLevelR{0.f};
-    juce::dsp::Gain<float> inputGain, outputGain;
-    juce::dsp::Gain<float> gain;
-    float mixIR1, mixIR2;
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
-    {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
-    }
+    juce::CriticalSection stateCacheLock;
+    juce::MemoryBlock cachedState;
+    
+    GainPlan gainPlan;
+    juce::AudioBuffer<float> irTempBuffer;   // second IR branch, sized in prepareToPlay
 
     using Filter = juce::dsp::IIR::Filter<float>;
     using Coefficients = juce::dsp::IIR::Coefficients<float>;
@@ -178,25 +212,40 @@ private:
 
     DelayProcessor delayInstance;
     
-//  ======== PARAMETERS FUNCTIONS ========
-    template<typename ParamType, typename Params, typename Funcs>
-    void initCachedParams(Params paramsArray, Funcs funcsArray)
-    {
-        for (size_t i = 0 ; i < paramsArray.size(); ++i)
-        {
-            auto ptrToParamPtr = paramsArray [i];
-            *ptrToParamPtr = dynamic_cast<ParamType>(apvts.getParameter(funcsArray[i]()));
-            jassert(*ptrToParamPtr != nullptr);
-        }
-    }
-    
-    
-    std::vector<juce::SmoothedValue<float>*> getSmoothers();
+    BypassManager bypassManager;
+    RestoreGate restoreGate;
+    bool restoreDeferred = false;   // a session arrived before prepareToPlay; its IRs still hold the output
+    
+    PresetSwitcher presetSwitcher { [this] (PresetSwitcher::Transaction& transaction) { commitPreset(transaction); } };
+    PresetSwitcher::BlockState presetBlock;     // this block's, from presetSwitcher.beginBlock()
+    int commitInProgress = 0;                   // while commitPreset runs: tags the engines it offers
+    std::array<IRCrossfade, 2> irCrossfades;
+    void processSegment(juce::AudioBuffer<float>&);
+    void processChain(juce::AudioBuffer<float>&);
+    void updateBypassStates(bool skipRamps);
+    void resetModuleState();
+    void applyPendingIR(int irIndex);
+    void commitPreset(PresetSwitcher::Transaction& transaction);
+    // Queues the slot's stored IR on the shared pool. holdOutput: gate the output until it arrives.
+    // Offline, builds it right here instead.
+    void restoreIR(int irIndex, bool holdOutput);
+    // For prepareToPlay offline: builds the slot's engine and installs it directly
+    void buildIRNow(int irIndex);
+    IRRestorePool::Source getIRSource(int irIndex) const;
+    // For loadIR1/loadIR2: offers a truncated engine for long IRs and builds the full one on the pool
+    bool loadIRProgressively(int irIndex, int generation, const juce::File& irFile);
+    static constexpr double previewSeconds = 0.15;
+    
+    void traceTransport();
+    int lastTracedPlaying = -1;
+    double lastTracedBpm = 0.0;
     
+//  ======== PARAMETERS FUNCTIONS ========
     enum class SmootherUpdateMode
     {
         initialize,
-        liveInRealTime
+        liveInRealTime,
+        morph           // a preset switch: ramps take the morph time
     };
     
     void updateSmootherFromParams(int numSamplesToSkip, SmootherUpdateMode init);
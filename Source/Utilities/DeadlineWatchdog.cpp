@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    DeadlineWatchdog.cpp
+    Created: 19 Oct 2026 8:42:18am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "DeadlineWatchdog.h"
+
+namespace
+{
+    void bump(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+DeadlineWatchdog::DeadlineWatchdog()
+{
+    setThresholds({ 0.5f, 0.8f, 1.0f });
+    sharedThread->addTimeSliceClient(this);
+}
+
+DeadlineWatchdog::~DeadlineWatchdog()
+{
+    sharedThread->removeTimeSliceClient(this);
+}
+
+void DeadlineWatchdog::setThresholds(const std::array<float, numThresholds>& newThresholds)
+{
+    for (size_t i = 0; i < thresholds.size(); ++i)
+        thresholds[i].store(newThresholds[i]);
+}
+
+std::array<float, DeadlineWatchdog::numThresholds> DeadlineWatchdog::getThresholds() const
+{
+    std::array<float, numThresholds> result {};
+    for (size_t i = 0; i < thresholds.size(); ++i)
+        result[i] = thresholds[i].load();
+    return result;
+}
+
+float DeadlineWatchdog::blockFinished(int numSamples, double sampleRate, const ParamSnapshot& snapshot,
+                                      const std::array<juce::int64, Profiling::numStages>* stageTicks)
+{
+    const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    if (numSamples <= 0 || sampleRate <= 0.0)
+        return 0.f;
+
+    const float load = static_cast<float>(elapsed * sampleRate / numSamples);
+
+    if (resetRequested.exchange(false, std::memory_order_acquire))
+        audioWorstLoads.fill(0.f);
+
+    const auto blockIndex = blockCount.load(std::memory_order_relaxed);
+    bump(blockCount);
+
+    for (size_t i = 0; i < thresholds.size(); ++i)
+        if (load >= thresholds[i].load(std::memory_order_relaxed))
+            bump(overCounts[i]);
+
+    auto weakest = std::min_element(audioWorstLoads.begin(), audioWorstLoads.end());
+    const bool isNewWorst = load > *weakest;
+    if (isNewWorst)
+        *weakest = load;
+
+    if (! isNewWorst && load < 1.f)
+        return load;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+    {
+        bump(droppedReports);
+        return load;
+    }
+
+    auto& report = ring[static_cast<size_t>(start1)];
+    report.blockIndex = blockIndex;
+    report.load = load;
+    report.elapsedMicros = elapsed * 1.0e6;
+    report.numSamples = numSamples;
+    report.sampleRate = sampleRate;
+    report.wallClockMillis = juce::Time::currentTimeMillis();
+    report.params = snapshot;
+    report.hasStageTimings = stageTicks != nullptr;
+
+    if (stageTicks != nullptr)
+        for (size_t s = 0; s < report.stageMicros.size(); ++s)
+            report.stageMicros[s] = static_cast<float>(juce::Time::highResolutionTicksToSeconds((*stageTicks)[s]) * 1.0e6);
+
+    fifo.finishedWrite(1);
+    return load;
+}
+
+std::vector<DeadlineWatchdog::BlockReport> DeadlineWatchdog::getWorstBlocks() const
+{
+    const juce::ScopedLock lock(worstLock);
+    return worstBlocks;
+}
+
+void DeadlineWatchdog::resetStats()
+{
+    blockCount.store(0);
+    droppedReports.store(0);
+    for (auto& count : overCounts)
+        count.store(0);
+
+    resetRequested.store(true, std::memory_order_release);
+
+    const juce::ScopedLock lock(worstLock);
+    worstBlocks.clear();
+}
+
+juce::File DeadlineWatchdog::getLogFile() const
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("IRFx/Logs/IRFx-Deadlines.log");
+}
+
+int DeadlineWatchdog::useTimeSlice()
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    auto handle = [this] (const BlockReport& report)
+    {
+        {
+            const juce::ScopedLock lock(worstLock);
+            worstBlocks.push_back(report);
+            std::sort(worstBlocks.begin(), worstBlocks.end(), [] (const auto& a, const auto& b) { return a.load > b.load; });
+            if (worstBlocks.size() > numWorstBlocks)
+                worstBlocks.resize(numWorstBlocks);
+        }
+
+        // Early worst-N entries of an idle session aren't worth a log line
+        if (report.load >= thresholds[0].load())
+            log(report);
+    };
+
+    for (int i = 0; i < size1; ++i)
+        handle(ring[static_cast<size_t>(start1 + i)]);
+    for (int i = 0; i < size2; ++i)
+        handle(ring[static_cast<size_t>(start2 + i)]);
+
+    fifo.finishedRead(size1 + size2);
+    return 250;
+}
+
+void DeadlineWatchdog::log(const BlockReport& report)
+{
+    if (logger == nullptr)
+        logger = std::make_unique<juce::FileLogger>(getLogFile(), "IRFx deadline reports", 1024 * 1024);
+
+    const double budgetMillis = 1000.0 * report.numSamples / report.sampleRate;
+
+    juce::String line;
+    line << juce::Time(report.wallClockMillis).toString(true, true, true, true)
+         << "  block " << juce::String(static_cast<juce::int64>(report.blockIndex))
+         << (report.load >= 1.f ? "  OVERRUN " : "  worst ")
+         << juce::String(report.load * 100.f, 1) << "% of " << juce::String(budgetMillis, 2) << " ms ("
+         << report.numSamples << " @ " << juce::String(report.sampleRate, 0) << " Hz)";
+
+    line << "\n    stages:";
+    if (report.hasStageTimings)
+    {
+        for (int s = 0; s < Profiling::numStages; ++s)
+            line << " " << Profiling::getStageName(static_cast<Profiling::Stage>(s)) << "="
+                 << juce::String(report.stageMicros[static_cast<size_t>(s)], 1) << "us";
+    }
+    else
+    {
+        line << " (build with IRFX_ENABLE_PROFILING=1)";
+    }
+
+    line << "\n    params:";
+    for (const auto& spec : Params::table)
+        line << " " << spec.id << "=" << juce::String(report.params.get(spec.index), 2);
+
+    line << " IR1=" << (report.params.ir1Loaded ? (report.params.ir1Muted ? "muted" : "on") : "empty")
+         << " IR2=" << (report.params.ir2Loaded ? (report.params.ir2Muted ? "muted" : "on") : "empty");
+
+    logger->logMessage(line);
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    DeadlineWatchdog.h
+    Created: 19 Oct 2026 8:42:18am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../ParamSnapshot.h"
+#include "StageProfiler.h"
+
+/**
+ * Compares every processBlock against its real-time budget (numSamples / sampleRate).
+ *
+ * The audio thread counts blocks over each load threshold and, for blocks that
+ * make the worst-N list or overrun outright, pushes a report (load, parameter
+ * snapshot, stage timings) into an SPSC ring. A shared background thread keeps
+ * the worst-N list for the API and appends each report to
+ * ~/Documents/IRFx/Logs/IRFx-Deadlines.log.
+ */
+class DeadlineWatchdog : private juce::TimeSliceClient
+{
+public:
+    static constexpr int numThresholds = 3;
+    static constexpr int numWorstBlocks = 8;
+
+    struct BlockReport
+    {
+        uint64_t blockIndex = 0;
+        float load = 0.f;                   // elapsed / budget
+        double elapsedMicros = 0.0;
+        int numSamples = 0;
+        double sampleRate = 0.0;
+        juce::int64 wallClockMillis = 0;
+
+        ParamSnapshot params;
+        bool hasStageTimings = false;       // only in IRFX_ENABLE_PROFILING builds
+        std::array<float, Profiling::numStages> stageMicros {};
+    };
+
+    DeadlineWatchdog();
+    ~DeadlineWatchdog() override;
+
+    // Fractions of the budget, ascending. Defaults to 50%, 80% and 100%.
+    void setThresholds(const std::array<float, numThresholds>& newThresholds);
+    std::array<float, numThresholds> getThresholds() const;
+
+    //========================    AUDIO THREAD    ========================
+    void blockStarted() { startTicks = juce::Time::getHighResolutionTicks(); }
+
+    // stageTicks may be nullptr when the profiler is compiled out. Returns the block's load.
+    float blockFinished(int numSamples, double sampleRate, const ParamSnapshot& snapshot,
+                        const std::array<juce::int64, Profiling::numStages>* stageTicks);
+
+    //========================    ANY OTHER THREAD    ========================
+    uint64_t getBlockCount() const { return blockCount.load(); }
+    uint64_t getCountOver(int thresholdIndex) const { return overCounts[static_cast<size_t>(thresholdIndex)].load(); }
+    uint64_t getDroppedReportCount() const { return droppedReports.load(); }
+
+    // Worst blocks seen so far, worst first (as far as the background thread has caught up)
+    std::vector<BlockReport> getWorstBlocks() const;
+
+    void resetStats();
+    juce::File getLogFile() const;
+
+private:
+    int useTimeSlice() override;
+    void log(const BlockReport& report);
+
+    std::array<std::atomic<float>, numThresholds> thresholds;
+    std::array<std::atomic<uint64_t>, numThresholds> overCounts {};
+    std::atomic<uint64_t> blockCount { 0 }, droppedReports { 0 };
+    std::atomic<bool> resetRequested { false };
+
+    // Audio thread only
+    juce::int64 startTicks = 0;
+    std::array<float, numWorstBlocks> audioWorstLoads {};
+
+    static constexpr int ringSize = 32;
+    juce::AbstractFifo fifo { ringSize };
+    std::array<BlockReport, ringSize> ring;
+
+    // Background thread side
+    mutable juce::CriticalSection worstLock;
+    std::vector<BlockReport> worstBlocks;
+    std::unique_ptr<juce::FileLogger> logger;
+
+    // One low-priority thread shared by every IRFx instance in the process
+    struct SharedThread : juce::TimeSliceThread
+    {
+        SharedThread() : juce::TimeSliceThread("IRFx Diagnostics") { startThread(juce::Thread::Priority::low); }
+        ~SharedThread() override { stopThread(2000); }
+    };
+
+    juce::SharedResourcePointer<SharedThread> sharedThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeadlineWatchdog)
+};
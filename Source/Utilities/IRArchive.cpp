@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    IRArchive.cpp
+    Created: 19 Oct 2026 8:59:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRArchive.h"
+
+namespace
+{
+    const juce::Identifier embeddedIRsType ("EmbeddedIRs");
+    const juce::Identifier irType ("IR");
+    const juce::Identifier hashProperty ("hash");
+    const juce::Identifier dataProperty ("data");
+    const juce::Identifier modeProperty ("IREmbedMode");
+    const std::array<juce::Identifier, 2> slotProperties { "IR1Embedded", "IR2Embedded" };
+}
+
+//==============================================================================
+IRArchive::EntryPtr IRArchive::encode(const juce::File& file, Mode mode)
+{
+    if (mode == Mode::off || ! file.existsAsFile())
+        return nullptr;
+
+    const auto modified = file.getLastModificationTime();
+    const juce::ScopedLock sl (cacheLock);
+
+    for (const auto& cached : cache)
+        if (cached.file == file && cached.modified == modified && cached.mode == mode)
+            return cached.entry;
+
+    IRReader reader (file);
+    if (! reader.isValid())
+        return nullptr;
+
+    auto data = encodeTrimmed(reader, mode);
+    if (data.isEmpty())
+        return nullptr;
+
+    auto entry = std::make_shared<Entry>();
+    entry->hash = hashOf(data);
+    entry->data = std::move(data);
+
+    if (cache.size() >= maxCachedFiles)
+        cache.erase(cache.begin());
+    cache.push_back({ file, modified, mode, entry });
+
+    return entry;
+}
+
+juce::MemoryBlock IRArchive::encodeTrimmed(IRReader& reader, Mode mode)
+{
+    // Trimmed the way Convolution does it, so trimming again on load is a no-op
+    const auto trimmed = reader.readTrimmed();
+    const int numChannels = trimmed.getNumChannels();
+    if (trimmed.getNumSamples() == 0)
+        return {};
+
+    // FLAC tops out at 24-bit integers, so float sources stay float WAV even when
+    // compressing; WAV keeps whatever the source had
+    const bool sourceIsFloat = reader.getFormatReader().usesFloatingPointData;
+    const int sourceBits = static_cast<int>(reader.getFormatReader().bitsPerSample);
+    const bool useFlac = mode == Mode::compressed && ! sourceIsFloat;
+    const int bitDepth = useFlac ? (sourceBits <= 16 ? 16 : 24)
+                                 : (sourceIsFloat ? 32 : juce::jlimit(16, 32, sourceBits));
+
+    juce::MemoryBlock data;
+    auto stream = std::make_unique<juce::MemoryOutputStream>(data, false);
+
+    juce::WavAudioFormat wav;
+    juce::FlacAudioFormat flac;
+    juce::AudioFormat& format = useFlac ? static_cast<juce::AudioFormat&>(flac) : wav;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer (format.createWriterFor(stream.get(), reader.getSampleRate(),
+                                                                            static_cast<unsigned int>(numChannels),
+                                                                            bitDepth, {}, 0));
+    if (writer == nullptr)
+        return {};
+
+    stream.release();   // owned by the writer now
+    if (! writer->writeFromAudioSampleBuffer(trimmed, 0, trimmed.getNumSamples()))
+        return {};
+
+    writer.reset();     // flushes into data
+    return data;
+}
+
+juce::String IRArchive::hashOf(const juce::MemoryBlock& data)
+{
+    // FNV-1a; only has to tell two IRs in one state apart
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < data.getSize(); ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+
+    return juce::String::toHexString(static_cast<juce::int64>(hash)) + "-" + juce::String(static_cast<juce::int64>(data.getSize()));
+}
+
+//==============================================================================
+void IRArchive::write(juce::ValueTree& state, const SlotEntries& slots)
+{
+    juce::ValueTree embedded (embeddedIRsType);
+
+    for (size_t slot = 0; slot < slots.size(); ++slot)
+    {
+        const auto& entry = slots[slot];
+        if (entry == nullptr)
+            continue;
+
+        state.setProperty(slotProperties[slot], entry->hash, nullptr);
+
+        if (! embedded.getChildWithProperty(hashProperty, entry->hash).isValid())
+        {
+            juce::ValueTree ir (irType);
+            ir.setProperty(hashProperty, entry->hash, nullptr);
+            ir.setProperty(dataProperty, entry->data, nullptr);
+            embedded.appendChild(ir, nullptr);
+        }
+    }
+
+    if (embedded.getNumChildren() > 0)
+        state.appendChild(embedded, nullptr);
+}
+
+IRArchive::SlotEntries IRArchive::read(juce::ValueTree& state)
+{
+    SlotEntries slots;
+    const auto embedded = state.getChildWithName(embeddedIRsType);
+
+    for (size_t slot = 0; slot < slots.size(); ++slot)
+    {
+        const auto hash = state.getProperty(slotProperties[slot]).toString();
+        state.removeProperty(slotProperties[slot], nullptr);
+
+        if (hash.isEmpty() || ! embedded.isValid())
+            continue;
+
+        // The other slot may already have decoded the same entry
+        for (const auto& other : slots)
+            if (other != nullptr && other->hash == hash)
+                slots[slot] = other;
+
+        if (slots[slot] != nullptr)
+            continue;
+
+        const auto ir = embedded.getChildWithProperty(hashProperty, hash);
+        auto entry = std::make_shared<Entry>();
+        entry->hash = hash;
+
+        // Raw in the binary state format; states saved as XML carry it as base64 text
+        const auto& data = ir.getProperty(dataProperty);
+        if (const auto* block = data.getBinaryData())
+            entry->data = *block;
+        else
+            entry->data.fromBase64Encoding(data.toString());
+
+        if (! entry->data.isEmpty())
+            slots[slot] = entry;
+    }
+
+    if (embedded.isValid())
+        state.removeChild(embedded, nullptr);
+
+    return slots;
+}
+
+IRArchive::Mode IRArchive::getMode(const juce::ValueTree& state)
+{
+    return static_cast<Mode>(juce::jlimit(0, 2, static_cast<int>(state.getProperty(modeProperty, 0))));
+}
+
+void IRArchive::setMode(juce::ValueTree& state, Mode mode)
+{
+    state.setProperty(modeProperty, static_cast<int>(mode), nullptr);
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    IRArchive.h
+    Created: 19 Oct 2026 8:59:09am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "IRReader.h"
+
+/**
+ * Packs the loaded impulse responses into the plugin state, so a session recalls
+ * its IRs without the original files being on disk.
+ *
+ * Each IR is trimmed of leading and trailing silence (as Convolution::Trim::yes
+ * would do on load) and stored as a WAV or FLAC file image. FLAC keeps 16/24-bit
+ * sources bit-exact; float sources are always stored as float WAV, since FLAC can't
+ * hold them losslessly. Both slots share one entry when they use the same audio.
+ *
+ * In the state this is an <EmbeddedIRs> child holding one <IR> per distinct entry;
+ * the slots point at them through "IR1Embedded"/"IR2Embedded" hashes. The child only
+ * exists in what getStateInformation writes, never in the live apvts state.
+ */
+class IRArchive
+{
+public:
+    enum class Mode
+    {
+        off,
+        uncompressed,
+        compressed
+    };
+
+    struct Entry
+    {
+        juce::String hash;          // of the encoded data; used to dedupe
+        juce::MemoryBlock data;     // a complete WAV or FLAC file
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+    using SlotEntries = std::array<EntryPtr, 2>;
+
+    // Reads, trims and encodes an IR file. Cached by path, modification time and mode,
+    // so repeated state saves don't touch the disk. nullptr if the file can't be read.
+    EntryPtr encode(const juce::File& file, Mode mode);
+
+    // Adds the <EmbeddedIRs> child and the slot references to a copy of the state
+    static void write(juce::ValueTree& state, const SlotEntries& slots);
+
+    // Removes the <EmbeddedIRs> child and slot references from the state and returns what they held
+    static SlotEntries read(juce::ValueTree& state);
+
+    static Mode getMode(const juce::ValueTree& state);
+    static void setMode(juce::ValueTree& state, Mode mode);
+
+private:
+    struct CachedFile
+    {
+        juce::File file;
+        juce::Time modified;
+        Mode mode;
+        EntryPtr entry;
+    };
+
+    static juce::MemoryBlock encodeTrimmed(IRReader& reader, Mode mode);
+    static juce::String hashOf(const juce::MemoryBlock& data);
+
+    juce::CriticalSection cacheLock;
+    std::vector<CachedFile> cache;      // a few entries: the current and recently replaced IRs
+    static constexpr size_t maxCachedFiles = 4;
+};
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    IRCache.cpp
+    Created: 19 Oct 2026 9:14:21am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRCache.h"
+
+IRCache::IRCache() : juce::Thread("IRFx IR prefetch")
+{
+    if (const int limitMB = settings.getIntValue("IRCacheLimitMB"); limitMB > 0)
+        limitBytes = static_cast<size_t>(limitMB) * 1024 * 1024;
+
+    startThread(juce::Thread::Priority::background);
+}
+
+juce::PropertiesFile::Options IRCache::getSettingsOptions()
+{
+    // Next to the IR index, in the user's application data
+    juce::PropertiesFile::Options options;
+    options.applicationName = "IRFx";
+    options.filenameSuffix = "settings";
+    options.folderName = "IRFx";
+    options.osxLibrarySubFolder = "Application Support";
+    return options;
+}
+
+IRCache::~IRCache()
+{
+    stopThread(2000);
+}
+
+juce::String IRCache::keyOf(const Source& source)
+{
+    // A file is the same IR until it is rewritten
+    if (source.embedded != nullptr)
+        return "embedded:" + source.embedded->hash;
+
+    return source.file.getFullPathName() + ":" + juce::String(source.file.getLastModificationTime().toMilliseconds())
+         + ":" + juce::String(source.file.getSize());
+}
+
+IRCache::AudioPtr IRCache::load(const Source& source)
+{
+    if (! source.isValid())
+        return nullptr;
+
+    const auto key = keyOf(source);
+    {
+        const juce::ScopedLock sl (lock);
+        if (const auto it = byKey.find(key); it != byKey.end())
+        {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->audio;
+        }
+    }
+
+    // Decoded outside the lock; two threads asking at once both decode, the second insert wins
+    auto audio = decode(source);
+    if (audio != nullptr)
+        insert(key, audio);
+    return audio;
+}
+
+bool IRCache::contains(const Source& source) const
+{
+    const auto key = keyOf(source);
+    const juce::ScopedLock sl (lock);
+    return byKey.find(key) != byKey.end();
+}
+
+IRCache::AudioPtr IRCache::decode(const Source& source)
+{
+    IRReader reader = source.embedded != nullptr ? IRReader(source.embedded->data) : IRReader(source.file);
+    if (! reader.isValid())
+        return nullptr;
+
+    // Only the audible range is read (and, for WAV/AIFF, paged in); it is all Convolution keeps with Trim::yes
+    auto audio = std::make_shared<Audio>();
+    audio->sampleRate = reader.getSampleRate();
+    audio->buffer = reader.readTrimmed();
+    if (audio->buffer.getNumSamples() == 0)
+        return nullptr;
+    return audio;
+}
+
+size_t IRCache::bytesOf(const Audio& audio)
+{
+    return static_cast<size_t>(audio.buffer.getNumChannels()) * static_cast<size_t>(audio.buffer.getNumSamples()) * sizeof(float);
+}
+
+bool IRCache::insert(const juce::String& key, AudioPtr audio, const std::set<juce::String>& keep)
+{
+    const auto bytes = bytesOf(*audio);
+
+    const juce::ScopedLock sl (lock);
+    if (byKey.find(key) != byKey.end())
+        return true;
+    if (bytes > limitBytes.load())
+        return false;
+
+    // Walk what trim() would evict, oldest first
+    size_t freed = 0;
+    for (auto it = entries.rbegin(); it != entries.rend() && bytesUsed - freed + bytes > limitBytes.load(); ++it)
+    {
+        if (keep.count(it->key) > 0)
+            return false;
+        freed += it->bytes;
+    }
+
+    entries.push_front({ key, std::move(audio), bytes });
+    byKey[key] = entries.begin();
+    bytesUsed += bytes;
+    trim();
+    return true;
+}
+
+void IRCache::trim()
+{
+    // An engine being built from an evicted entry keeps it alive until it's done
+    while (bytesUsed > limitBytes.load() && ! entries.empty())
+    {
+        bytesUsed -= entries.back().bytes;
+        byKey.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+void IRCache::setLimitBytes(size_t newLimit)
+{
+    limitBytes = newLimit;
+    settings.setValue("IRCacheLimitMB", static_cast<int>(newLimit / (1024 * 1024)));
+
+    const juce::ScopedLock sl (lock);
+    trim();
+}
+
+size_t IRCache::getBytesUsed() const
+{
+    const juce::ScopedLock sl (lock);
+    return bytesUsed;
+}
+
+void IRCache::prefetch(const std::vector<Source>& sources)
+{
+    {
+        const juce::ScopedLock sl (queueLock);
+        queue.assign(sources.begin(), sources.end());
+        ++queueRound;
+    }
+    notify();
+}
+
+void IRCache::run()
+{
+    // The list is most wanted first, so each entry lands in front of the ones wanted more; once
+    // the cap is reached, going on would evict those first
+    std::set<juce::String> fetched;
+    int fetchedRound = 0;
+
+    while (! threadShouldExit())
+    {
+        Source next;
+        bool hasNext = false;
+        {
+            const juce::ScopedLock sl (queueLock);
+            if (queueRound != fetchedRound)
+            {
+                fetched.clear();
+                fetchedRound = queueRound;
+            }
+
+            if (! queue.empty())
+            {
+                next = std::move(queue.front());
+                queue.pop_front();
+                hasNext = true;
+            }
+        }
+
+        if (! hasNext)
+        {
+            wait(-1);
+            continue;
+        }
+
+        if (! next.isValid())
+            continue;
+
+        const auto key = keyOf(next);
+        {
+            const juce::ScopedLock sl (lock);
+            if (const auto it = byKey.find(key); it != byKey.end())
+            {
+                entries.splice(entries.begin(), entries, it->second);
+                fetched.insert(key);
+                continue;
+            }
+        }
+
+        // One too big for the whole cache is skipped, not a reason to stop
+        auto audio = decode(next);
+        if (audio == nullptr || bytesOf(*audio) > limitBytes.load())
+            continue;
+
+        if (insert(key, std::move(audio), fetched))
+        {
+            fetched.insert(key);
+            continue;
+        }
+
+        // Full of this list's own entries: leave the rest of it, unless a new list came meanwhile
+        const juce::ScopedLock sl (queueLock);
+        if (queueRound == fetchedRound)
+            queue.clear();
+    }
+}
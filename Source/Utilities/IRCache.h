@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    IRCache.h
+    Created: 19 Oct 2026 9:14:21am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include "IRArchive.h"
+#include "IRReader.h"
+
+/**
+ * Decoded IR audio, shared by every IRFx instance in the process (hold it through a
+ * juce::SharedResourcePointer) and capped in bytes: the least recently used entries
+ * go first once the cap is reached.
+ *
+ * Every IR built on the IRRestorePool reads through here, so an IR used by several
+ * instances or several presets is decoded once. prefetch() fills it ahead of time on
+ * a low-priority thread of its own, for the presets likely to be switched to next.
+ *
+ * Audio is kept at the file's own rate, already trimmed (see IRReader); Convolution
+ * resamples while preparing. The cap is a machine setting, kept in IRFx's settings file
+ * rather than in any session.
+ */
+class IRCache : private juce::Thread
+{
+public:
+    // Either an embedded IR or a file
+    struct Source
+    {
+        IRArchive::EntryPtr embedded;
+        juce::File file;
+
+        bool isValid() const { return embedded != nullptr || file.existsAsFile(); }
+    };
+
+    struct Audio
+    {
+        juce::AudioBuffer<float> buffer;    // up to two channels
+        double sampleRate = 0.0;
+    };
+    using AudioPtr = std::shared_ptr<const Audio>;
+
+    IRCache();
+    ~IRCache() override;
+
+    // Any thread. Cached audio, or decodes it now and caches it; nullptr if it can't be read.
+    AudioPtr load(const Source& source);
+    bool contains(const Source& source) const;
+
+    // Replaces the prefetch queue: sources are decoded in order, most wanted first. Stops
+    // early rather than evict an entry fetched earlier from the same list.
+    void prefetch(const std::vector<Source>& sources);
+
+    // Message thread. Remembered for every later process, too.
+    void setLimitBytes(size_t newLimit);
+    size_t getLimitBytes() const    { return limitBytes.load(); }
+    size_t getBytesUsed() const;
+
+    static constexpr size_t defaultLimitBytes = 128 * 1024 * 1024;
+
+private:
+    struct Entry
+    {
+        juce::String key;
+        AudioPtr audio;
+        size_t bytes;
+    };
+
+    void run() override;
+    static juce::String keyOf(const Source& source);
+    static AudioPtr decode(const Source& source);
+    static size_t bytesOf(const Audio& audio);
+    // False if it didn't fit without evicting one of keep
+    bool insert(const juce::String& key, AudioPtr audio, const std::set<juce::String>& keep = {});
+    void trim();
+
+    mutable juce::CriticalSection lock;
+    std::list<Entry> entries;          // most recently used first
+    std::map<juce::String, std::list<Entry>::iterator> byKey;
+    size_t bytesUsed = 0;
+    std::atomic<size_t> limitBytes { defaultLimitBytes };
+    juce::PropertiesFile settings { getSettingsOptions() };
+
+    static juce::PropertiesFile::Options getSettingsOptions();
+
+    juce::CriticalSection queueLock;
+    std::deque<Source> queue;
+    int queueRound = 0;                 // bumped by each prefetch()
+};
@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+    IRLibrary.cpp
+    Created: 19 Oct 2026 9:19:38am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRLibrary.h"
+
+namespace
+{
+    constexpr int magic = 0x49465249;   // "IRFI", little-endian
+    constexpr int formatVersion = 1;
+
+    // Enough for a cab IR's tone; room tails past it hardly move the centroid
+    constexpr int centroidFFTOrder = 13;
+    constexpr int centroidFFTSize = 1 << centroidFFTOrder;
+
+    bool byName(const IRLibrary::EntryPtr& a, const IRLibrary::EntryPtr& b)
+    {
+        const auto order = a->name.compareNatural(b->name);
+        return order != 0 ? order < 0 : a->file.getFullPathName() < b->file.getFullPathName();
+    }
+}
+
+IRLibrary::IRLibrary()
+    : juce::Thread("IRFx IR library"),
+      analysers(juce::ThreadPoolOptions{}
+                    .withThreadName("IRFx IR analysis")
+                    .withNumberOfThreads(juce::jmax(1, juce::SystemStats::getNumCpus() - 1))
+                    .withDesiredThreadPriority(juce::Thread::Priority::low))
+{
+    loadIndex();
+    startThread(juce::Thread::Priority::low);
+}
+
+IRLibrary::~IRLibrary()
+{
+    stopThread(4000);
+}
+
+juce::File IRLibrary::getDefaultFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("IRFx/IRs");
+}
+
+juce::File IRLibrary::getIndexFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("IRFx/IRIndex.bin");
+}
+
+juce::StringArray IRLibrary::getFolders() const
+{
+    const juce::ScopedLock sl (indexLock);
+    return folders;
+}
+
+void IRLibrary::addFolder(const juce::File& folder)
+{
+    {
+        const juce::ScopedLock sl (indexLock);
+        if (! folders.addIfNotAlreadyThere(folder.getFullPathName()))
+            return;
+    }
+    foldersChanged = true;
+    rescan();
+}
+
+void IRLibrary::removeFolder(const juce::File& folder)
+{
+    {
+        const juce::ScopedLock sl (indexLock);
+        folders.removeString(folder.getFullPathName());
+    }
+    foldersChanged = true;
+    rescan();
+}
+
+std::shared_ptr<const IRLibrary::Index> IRLibrary::getIndex() const
+{
+    const juce::ScopedLock sl (indexLock);
+    return index;
+}
+
+IRLibrary::Index IRLibrary::search(const Filter& filter) const
+{
+    const auto words = juce::StringArray::fromTokens(filter.text, true);
+    Index result;
+
+    for (const auto& entry : *getIndex())
+    {
+        // Unreadable files stay indexed, so they aren't re-read every scan, but aren't listed
+        if (entry->length == 0)
+            continue;
+        if (filter.numChannels != 0 && entry->numChannels != filter.numChannels)
+            continue;
+        if (! filter.lengthMs.isEmpty() && ! filter.lengthMs.contains(entry->getLengthMs()))
+            continue;
+
+        const bool matches = std::all_of(words.begin(), words.end(), [&entry] (const juce::String& word)
+        {
+            return entry->name.containsIgnoreCase(word) || entry->folder.containsIgnoreCase(word);
+        });
+
+        if (matches)
+            result.push_back(entry);
+    }
+
+    // Already by name
+    if (filter.order == SortOrder::length)
+        std::stable_sort(result.begin(), result.end(), [] (const EntryPtr& a, const EntryPtr& b) { return a->getLengthMs() < b->getLengthMs(); });
+    else if (filter.order == SortOrder::centroid)
+        std::stable_sort(result.begin(), result.end(), [] (const EntryPtr& a, const EntryPtr& b) { return a->centroidHz < b->centroidHz; });
+
+    return result;
+}
+
+IRLibrary::EntryPtr IRLibrary::find(const juce::File& file) const
+{
+    for (const auto& entry : *getIndex())
+        if (entry->file == file)
+            return entry;
+    return nullptr;
+}
+
+void IRLibrary::run()
+{
+    while (! threadShouldExit())
+    {
+        scan();
+        wait(checkIntervalMs);
+    }
+}
+
+void IRLibrary::scan()
+{
+    scanning = true;
+    getDefaultFolder().createDirectory();
+
+    std::map<juce::String, EntryPtr> known;
+    for (const auto& entry : *getIndex())
+        known[entry->file.getFullPathName()] = entry;
+
+    Index current;
+    std::vector<std::pair<juce::File, juce::File>> toAnalyse;     // file, library folder
+    std::set<juce::String> seen;                                    // folders may nest
+
+    for (const auto& path : getFolders())
+    {
+        const juce::File root (path);
+        if (! root.isDirectory())
+            continue;
+
+        for (const auto& item : juce::RangedDirectoryIterator(root, true, wildcard, juce::File::findFiles))
+        {
+            if (threadShouldExit())
+            {
+                scanning = false;
+                return;
+            }
+
+            const auto& file = item.getFile();
+            if (! seen.insert(file.getFullPathName()).second)
+                continue;
+
+            // Unchanged files keep their analysis; only new or rewritten ones are read
+            const auto it = known.find(file.getFullPathName());
+            if (it != known.end() && it->second->modified == item.getModificationTime() && it->second->fileSize == item.getFileSize())
+            {
+                current.push_back(it->second);
+                known.erase(it);
+            }
+            else
+            {
+                toAnalyse.emplace_back(file, root);
+            }
+        }
+    }
+
+    // Anything left in known was deleted or moved away
+    const bool changed = ! known.empty() || ! toAnalyse.empty() || foldersChanged.exchange(false);
+
+    for (size_t batchStart = 0; batchStart < toAnalyse.size(); batchStart += batchSize)
+    {
+        const auto batchEnd = juce::jmin(toAnalyse.size(), batchStart + batchSize);
+        std::vector<EntryPtr> analysed (batchEnd - batchStart);
+
+        for (size_t i = batchStart; i < batchEnd; ++i)
+            analysers.addJob([&analysed, &toAnalyse, i, batchStart] { analysed[i - batchStart] = analyse(toAnalyse[i].first, toAnalyse[i].second); });
+
+        while (analysers.getNumJobs() > 0)
+        {
+            if (threadShouldExit())
+            {
+                // Waits for running jobs: they write into this frame
+                analysers.removeAllJobs(true, -1);
+                scanning = false;
+                return;
+            }
+            wait(10);
+        }
+
+        for (auto& entry : analysed)
+            if (entry != nullptr)
+                current.push_back(std::move(entry));
+
+        // A first scan of a big library fills the browser as it goes
+        std::sort(current.begin(), current.end(), byName);
+        publish(std::make_shared<const Index>(current));
+    }
+
+    if (changed)
+    {
+        if (toAnalyse.empty())
+        {
+            std::sort(current.begin(), current.end(), byName);
+            publish(std::make_shared<const Index>(current));
+        }
+        saveIndex();
+    }
+
+    scanning = false;
+}
+
+IRLibrary::EntryPtr IRLibrary::analyse(const juce::File& file, const juce::File& root)
+{
+    auto entry = std::make_shared<Entry>();
+    entry->file = file;
+    entry->name = file.getFileNameWithoutExtension();
+    if (file.getParentDirectory() != root)
+        entry->folder = file.getParentDirectory().getRelativePathFrom(root);
+    entry->modified = file.getLastModificationTime();
+    entry->fileSize = file.getSize();
+
+    IRReader reader (file);
+    if (! reader.isValid())
+        return entry;
+
+    const auto range = reader.findAudibleRange();
+    entry->sampleRate = reader.getSampleRate();
+    entry->numChannels = reader.getNumChannels();
+    entry->length = range.getLength();
+    if (range.isEmpty())
+        return entry;
+
+    const auto sliceLength = (entry->length + thumbnailSize - 1) / thumbnailSize;
+    std::array<float, thumbnailSize> slicePeaks {};
+    std::vector<float> fftData (2 * centroidFFTSize, 0.f);
+    double sumOfSquares = 0.0;
+    uint64_t hash = 14695981039346656037ull;
+
+    // Straight from the mapping, a block at a time
+    reader.forEachBlock(range, [&] (const juce::AudioBuffer<float>& block, juce::int64 position)
+    {
+        const int numChannels = block.getNumChannels();
+        for (int i = 0; i < block.getNumSamples(); ++i)
+        {
+            const auto offset = position + i - range.getStart();
+            float samplePeak = 0.f, mono = 0.f;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float sample = block.getSample(ch, i);
+
+                // FNV-1a over the decoded samples: the same IR matches whatever its format or metadata
+                uint32_t bits;
+                std::memcpy(&bits, &sample, sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ull;
+
+                samplePeak = juce::jmax(samplePeak, std::abs(sample));
+                sumOfSquares += static_cast<double>(sample) * sample / numChannels;
+                mono += sample / static_cast<float>(numChannels);
+            }
+
+            auto& slicePeak = slicePeaks[static_cast<size_t>(offset / sliceLength)];
+            slicePeak = juce::jmax(slicePeak, samplePeak);
+            if (offset < centroidFFTSize)
+                fftData[static_cast<size_t>(offset)] = mono;
+        }
+    });
+
+    entry->hash = static_cast<juce::int64>(hash);
+    entry->peak = *std::max_element(slicePeaks.begin(), slicePeaks.end());
+    entry->rms = static_cast<float>(std::sqrt(sumOfSquares / static_cast<double>(entry->length)));
+    for (size_t i = 0; i < slicePeaks.size(); ++i)
+        entry->thumbnail[i] = static_cast<uint8_t>(juce::roundToInt(255.f * slicePeaks[i] / entry->peak));
+
+    juce::dsp::FFT fft (centroidFFTOrder);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    double weighted = 0.0, total = 0.0;
+    for (int bin = 1; bin <= centroidFFTSize / 2; ++bin)
+    {
+        const auto magnitude = static_cast<double>(fftData[static_cast<size_t>(bin)]);
+        weighted += magnitude * bin * entry->sampleRate / centroidFFTSize;
+        total += magnitude;
+    }
+    entry->centroidHz = total > 0.0 ? static_cast<float>(weighted / total) : 0.f;
+
+    return entry;
+}
+
+void IRLibrary::publish(std::shared_ptr<const Index> newIndex)
+{
+    {
+        const juce::ScopedLock sl (indexLock);
+        index = std::move(newIndex);
+    }
+    sendChangeMessage();
+}
+
+//==============================================================================
+void IRLibrary::loadIndex()
+{
+    juce::MemoryBlock data;
+    if (getIndexFile().loadFileAsData(data))
+    {
+        juce::MemoryInputStream stream (data, false);
+        if (stream.readInt() == magic && stream.readInt() == formatVersion)
+        {
+            const int numFolders = stream.readInt();
+            for (int i = 0; i < numFolders && ! stream.isExhausted(); ++i)
+                folders.add(stream.readString());
+
+            auto loaded = std::make_shared<Index>();
+            const int numEntries = stream.readInt();
+            for (int i = 0; i < numEntries && ! stream.isExhausted(); ++i)
+            {
+                auto entry = std::make_shared<Entry>();
+                entry->file = juce::File(stream.readString());
+                entry->name = entry->file.getFileNameWithoutExtension();
+                entry->folder = stream.readString();
+                entry->modified = juce::Time(stream.readInt64());
+                entry->fileSize = stream.readInt64();
+                entry->length = stream.readInt64();
+                entry->sampleRate = stream.readDouble();
+                entry->numChannels = stream.readInt();
+                entry->peak = stream.readFloat();
+                entry->rms = stream.readFloat();
+                entry->centroidHz = stream.readFloat();
+                entry->hash = stream.readInt64();
+                if (stream.read(entry->thumbnail.data(), thumbnailSize) != thumbnailSize)
+                    break;
+                loaded->push_back(std::move(entry));
+            }
+
+            std::sort(loaded->begin(), loaded->end(), byName);
+            index = std::move(loaded);
+        }
+    }
+
+    if (folders.isEmpty())
+        folders.add(getDefaultFolder().getFullPathName());
+}
+
+void IRLibrary::saveIndex() const
+{
+    const auto snapshot = getIndex();
+    const auto roots = getFolders();
+
+    juce::MemoryOutputStream stream;
+    stream.writeInt(magic);
+    stream.writeInt(formatVersion);
+
+    stream.writeInt(roots.size());
+    for (const auto& root : roots)
+        stream.writeString(root);
+
+    stream.writeInt(static_cast<int>(snapshot->size()));
+    for (const auto& entry : *snapshot)
+    {
+        stream.writeString(entry->file.getFullPathName());
+        stream.writeString(entry->folder);
+        stream.writeInt64(entry->modified.toMilliseconds());
+        stream.writeInt64(entry->fileSize);
+        stream.writeInt64(entry->length);
+        stream.writeDouble(entry->sampleRate);
+        stream.writeInt(entry->numChannels);
+        stream.writeFloat(entry->peak);
+        stream.writeFloat(entry->rms);
+        stream.writeFloat(entry->centroidHz);
+        stream.writeInt64(entry->hash);
+        stream.write(entry->thumbnail.data(), thumbnailSize);
+    }
+
+    // Written next to the old index and swapped in, so a crash never leaves half a file
+    const auto file = getIndexFile();
+    file.getParentDirectory().createDirectory();
+    file.replaceWithData(stream.getData(), stream.getDataSize());
+}
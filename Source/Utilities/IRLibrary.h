@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    IRLibrary.h
+    Created: 19 Oct 2026 9:19:38am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <set>
+#include "IRReader.h"
+
+/**
+ * Analysed index of every IR under the library folders, shared by all IRFx
+ * instances in the process (hold it through a juce::SharedResourcePointer).
+ *
+ * Each IR is read once (through IRReader, so only its audible part) for its
+ * length, rate, channels, peak/RMS, spectral centroid, a small waveform thumbnail
+ * and a content hash. The index is saved to a binary file and loaded on start, so
+ * browsing never waits for a scan.
+ *
+ * A background thread re-checks the folders every few seconds; only files that
+ * were added or changed (modification time or size) are analysed again, spread
+ * over a thread pool. Listeners get a change message whenever the index changes.
+ */
+class IRLibrary : public juce::ChangeBroadcaster,
+                  private juce::Thread
+{
+public:
+    static constexpr int thumbnailSize = 48;
+
+    struct Entry
+    {
+        juce::File file;
+        juce::String name;          // file name without extension
+        juce::String folder;        // relative to its library folder, for search
+        juce::Time modified;
+        juce::int64 fileSize = 0;
+
+        juce::int64 length = 0;     // audible samples, as Convolution keeps them
+        double sampleRate = 0.0;
+        int numChannels = 0;
+        float peak = 0.f, rms = 0.f;
+        float centroidHz = 0.f;
+        juce::int64 hash = 0;       // of the audible samples; equal for copies of one IR
+        std::array<uint8_t, thumbnailSize> thumbnail {};    // peak per slice, 0-255
+
+        double getLengthMs() const { return sampleRate > 0.0 ? 1000.0 * static_cast<double>(length) / sampleRate : 0.0; }
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+    using Index = std::vector<EntryPtr>;
+
+    enum class SortOrder { name, length, centroid };
+
+    struct Filter
+    {
+        juce::String text;          // every word must be in the name or folder
+        int numChannels = 0;        // 0 for any
+        juce::Range<double> lengthMs;   // empty for any
+        SortOrder order = SortOrder::name;
+    };
+
+    IRLibrary();
+    ~IRLibrary() override;
+
+    static juce::File getDefaultFolder();
+    juce::StringArray getFolders() const;
+    void addFolder(const juce::File& folder);
+    void removeFolder(const juce::File& folder);
+
+    // Sorted by name. Cheap: a shared snapshot, safe to keep while the library rescans.
+    std::shared_ptr<const Index> getIndex() const;
+    Index search(const Filter& filter) const;
+    EntryPtr find(const juce::File& file) const;
+
+    void rescan() { notify(); }
+    bool isScanning() const { return scanning.load(); }
+
+private:
+    void run() override;
+    void scan();
+    static EntryPtr analyse(const juce::File& file, const juce::File& root);
+    void publish(std::shared_ptr<const Index> newIndex);
+
+    void loadIndex();
+    void saveIndex() const;
+    static juce::File getIndexFile();
+
+    static constexpr int checkIntervalMs = 5000;
+    static constexpr size_t batchSize = 256;    // files analysed between index updates
+    static constexpr const char* wildcard = "*.wav;*.wave;*.aif;*.aiff;*.flac";
+
+    mutable juce::CriticalSection indexLock;
+    juce::StringArray folders;
+    std::shared_ptr<const Index> index = std::make_shared<const Index>();
+    std::atomic<bool> scanning { false };
+    std::atomic<bool> foldersChanged { false };
+    juce::ThreadPool analysers;
+};
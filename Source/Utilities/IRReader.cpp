@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    IRReader.cpp
+    Created: 19 Oct 2026 9:16:31am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRReader.h"
+
+IRReader::IRReader(const juce::File& file)
+{
+    // Uncompressed formats: map the file instead of streaming it
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader;
+    if (file.hasFileExtension("wav;wave;bwf"))
+        mappedReader.reset(juce::WavAudioFormat().createMemoryMappedReader(file));
+    else if (file.hasFileExtension("aif;aiff;aifc"))
+        mappedReader.reset(juce::AiffAudioFormat().createMemoryMappedReader(file));
+
+    if (mappedReader != nullptr && mappedReader->lengthInSamples > 0 && mappedReader->mapEntireFile())
+    {
+        reader = std::move(mappedReader);
+        isMapped = true;
+        return;
+    }
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    reader.reset(formatManager.createReaderFor(file));
+}
+
+IRReader::IRReader(const juce::MemoryBlock& fileImage)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    reader.reset(formatManager.createReaderFor(std::make_unique<juce::MemoryInputStream>(fileImage, false)));
+}
+
+bool IRReader::readBlock(juce::AudioBuffer<float>& block, juce::int64 start, int numSamples)
+{
+    block.setSize(getNumChannels(), numSamples, false, false, true);
+    return reader->read(&block, 0, numSamples, start, true, getNumChannels() > 1);
+}
+
+juce::Range<juce::int64> IRReader::findAudibleRange()
+{
+    if (! isValid())
+        return {};
+
+    const float threshold = getTrimThreshold();
+    const juce::int64 length = getLength();
+    juce::AudioBuffer<float> block;
+
+    const auto isAudible = [&block, threshold] (int i)
+    {
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            if (std::abs(block.getSample(ch, i)) >= threshold)
+                return true;
+        return false;
+    };
+
+    // Forwards from the start to the first audible sample...
+    juce::int64 start = length;
+    for (juce::int64 position = 0; position < length && start == length; position += blockSize)
+    {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, length - position));
+        if (! readBlock(block, position, numSamples))
+            return {};
+
+        for (int i = 0; i < numSamples; ++i)
+            if (isAudible(i))
+            {
+                start = position + i;
+                break;
+            }
+    }
+
+    if (start == length)
+        return {};
+
+    // ...and backwards from the end to the last one; the middle is never read
+    juce::int64 end = start + 1;
+    for (juce::int64 position = length; position > start; position -= blockSize)
+    {
+        const juce::int64 blockStart = juce::jmax(start, position - blockSize);
+        const int numSamples = static_cast<int>(position - blockStart);
+        if (! readBlock(block, blockStart, numSamples))
+            return {};
+
+        bool found = false;
+        for (int i = numSamples - 1; i >= 0 && ! found; --i)
+            if (isAudible(i))
+            {
+                end = blockStart + i + 1;
+                found = true;
+            }
+
+        if (found)
+            break;
+    }
+
+    return { start, end };
+}
+
+juce::AudioBuffer<float> IRReader::read(juce::Range<juce::int64> range)
+{
+    range = range.getIntersectionWith({ 0, isValid() ? getLength() : 0 });
+    if (range.isEmpty())
+        return {};
+
+    juce::AudioBuffer<float> audio;
+    if (! readBlock(audio, range.getStart(), static_cast<int>(range.getLength())))
+        return {};
+    return audio;
+}
+
+void IRReader::forEachBlock(juce::Range<juce::int64> range, const BlockVisitor& visit)
+{
+    range = range.getIntersectionWith({ 0, isValid() ? getLength() : 0 });
+    juce::AudioBuffer<float> block;
+
+    for (auto position = range.getStart(); position < range.getEnd(); position += blockSize)
+    {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, range.getEnd() - position));
+        if (! readBlock(block, position, numSamples))
+            return;
+        visit(block, position);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    IRReader.h
+    Created: 19 Oct 2026 9:16:31am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Reads an impulse response with as little I/O and copying as possible.
+ *
+ * WAV and AIFF files are memory-mapped, so the OS only pages in what is touched:
+ * finding the trim points reads the silent head and tail, read() the audible part.
+ * FLAC, and anything else AudioFormatManager::registerBasicFormats() knows, is
+ * streamed instead. Embedded IRs are read from their in-memory file image.
+ *
+ * Trims like juce::dsp::Convolution::Trim::yes (-80 dB, before any resampling),
+ * so trimming again on load changes nothing. At most two channels are read, as
+ * Convolution::Stereo::yes keeps.
+ */
+class IRReader
+{
+public:
+    explicit IRReader(const juce::File& file);
+    // fileImage (a complete WAV/FLAC/... file) must outlive the reader
+    explicit IRReader(const juce::MemoryBlock& fileImage);
+
+    bool isValid() const            { return reader != nullptr && reader->lengthInSamples > 0; }
+    bool isMemoryMapped() const     { return isMapped; }
+
+    double getSampleRate() const    { return reader->sampleRate; }
+    int getNumChannels() const      { return juce::jmin(maxChannels, static_cast<int>(reader->numChannels)); }
+    juce::int64 getLength() const   { return reader->lengthInSamples; }
+    const juce::AudioFormatReader& getFormatReader() const { return *reader; }
+
+    // From the first to one past the last sample at or above the trim threshold; empty if all silent
+    juce::Range<juce::int64> findAudibleRange();
+
+    juce::AudioBuffer<float> read(juce::Range<juce::int64> range);
+    juce::AudioBuffer<float> readTrimmed() { return read(findAudibleRange()); }
+
+    // Visits range in blocks of up to blockSize samples, for analysis without copying the whole IR.
+    // position is where the block starts in the file.
+    using BlockVisitor = std::function<void(const juce::AudioBuffer<float>& block, juce::int64 position)>;
+    void forEachBlock(juce::Range<juce::int64> range, const BlockVisitor& visit);
+
+    static constexpr int maxChannels = 2;
+    static constexpr int blockSize = 4096;
+    static float getTrimThreshold() { return juce::Decibels::decibelsToGain(-80.f); }
+
+private:
+    bool readBlock(juce::AudioBuffer<float>& block, juce::int64 start, int numSamples);
+
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    bool isMapped = false;
+};
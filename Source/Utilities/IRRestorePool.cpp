@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    IRRestorePool.cpp
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "IRRestorePool.h"
+
+IRRestorePool::IRRestorePool()
+    : pool(juce::ThreadPoolOptions{}
+               .withThreadName("IRFx IR restore")
+               .withNumberOfThreads(juce::jmax(1, juce::SystemStats::getNumCpus())))
+{
+}
+
+void IRRestorePool::restore(std::shared_ptr<IRHandOver> handOver, int irIndex, int generation,
+                            Source source, const juce::dsp::ProcessSpec& spec)
+{
+    // Only the hand-over and copies are captured: the instance may be gone by the time this runs
+    prepare(std::move(source), spec, [handOver, irIndex, generation] (std::unique_ptr<juce::dsp::Convolution> engine)
+    {
+        // Dropped here, on this thread, if a newer request superseded it
+        if (engine != nullptr)
+            handOver->offer(irIndex, generation, std::move(engine));
+        else
+            handOver->cancel(irIndex, generation);
+    },
+    [handOver, irIndex, generation] { return handOver->isCurrent(irIndex, generation); });
+}
+
+void IRRestorePool::prepare(Source source, const juce::dsp::ProcessSpec& spec, EngineCallback onDone,
+                            std::function<bool()> isWanted)
+{
+    pool.addJob([this, source = std::move(source), spec, onDone = std::move(onDone), isWanted = std::move(isWanted)]
+    {
+        // Superseded while queued, e.g. by auditioning through IRs faster than they build
+        if (isWanted && ! isWanted())
+        {
+            onDone(nullptr);
+            return;
+        }
+
+        // Decoded once per process, however many instances and presets use it
+        const auto audio = cache->load(source);
+        if (audio == nullptr)
+        {
+            onDone(nullptr);
+            return;
+        }
+
+        onDone(makeEngine(*audio, spec));
+    });
+}
+
+std::unique_ptr<juce::dsp::Convolution> IRRestorePool::makeEngine(const IRCache::Audio& audio, const juce::dsp::ProcessSpec& spec)
+{
+    auto engine = std::make_unique<juce::dsp::Convolution>();
+    engine->loadImpulseResponse(juce::AudioBuffer<float>(audio.buffer), audio.sampleRate,
+                                juce::dsp::Convolution::Stereo::yes,
+                                juce::dsp::Convolution::Trim::yes,
+                                juce::dsp::Convolution::Normalise::yes);
+
+    // prepare() runs the queued load right here: resample and FFT partitioning
+    engine->prepare(spec);
+    return engine;
+}
+
+std::unique_ptr<juce::dsp::Convolution> IRRestorePool::makePreviewEngine(const IRCache::Audio& audio, int numSamples,
+                                                                         const juce::dsp::ProcessSpec& spec)
+{
+    const int numChannels = audio.buffer.getNumChannels();
+    numSamples = juce::jmin(numSamples, audio.buffer.getNumSamples());
+
+    // Normalise::yes would bring the head up to full-IR energy on its own. Scale it the way the
+    // full engine will be scaled instead: Convolution normalises the resampled IR (energy grows
+    // with the rate ratio) to 0.125 / sqrt(loudest channel's energy), and with Normalise::no it
+    // applies the inverse rate ratio itself.
+    float maxEnergy = 0.f;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float* samples = audio.buffer.getReadPointer(ch);
+        float energy = 0.f;
+        for (int i = 0; i < audio.buffer.getNumSamples(); ++i)
+            energy += samples[i] * samples[i];
+        maxEnergy = juce::jmax(maxEnergy, energy);
+    }
+
+    const auto rateRatio = static_cast<float>(spec.sampleRate / audio.sampleRate);
+    const float gain = 0.125f * std::sqrt(rateRatio / maxEnergy);
+
+    juce::AudioBuffer<float> head (numChannels, numSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+        head.copyFrom(ch, 0, audio.buffer, ch, 0, numSamples);
+    head.applyGain(gain);
+
+    // A short fade at the cut, so the truncated tail doesn't end in a click
+    const int fadeLength = juce::jmin(numSamples / 4, static_cast<int>(audio.sampleRate * 0.005));
+    head.applyGainRamp(numSamples - fadeLength, fadeLength, 1.f, 0.f);
+
+    auto engine = std::make_unique<juce::dsp::Convolution>();
+    engine->loadImpulseResponse(std::move(head), audio.sampleRate,
+                                juce::dsp::Convolution::Stereo::yes,
+                                juce::dsp::Convolution::Trim::no,
+                                juce::dsp::Convolution::Normalise::no);
+    engine->prepare(spec);
+    return engine;
+}
+
+std::unique_ptr<juce::dsp::Convolution> IRRestorePool::makeSilentEngine(const juce::dsp::ProcessSpec& spec)
+{
+    // A single zero sample; an empty IR would make Convolution fall back to a pass-through impulse
+    juce::AudioBuffer<float> silence (2, 1);
+    silence.clear();
+
+    auto engine = std::make_unique<juce::dsp::Convolution>();
+    engine->loadImpulseResponse(std::move(silence), spec.sampleRate,
+                                juce::dsp::Convolution::Stereo::yes,
+                                juce::dsp::Convolution::Trim::no,
+                                juce::dsp::Convolution::Normalise::no);
+    engine->prepare(spec);
+    return engine;
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    IRRestorePool.h
+    Created: 19 Oct 2026 9:05:26am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "IRArchive.h"
+#include "IRCache.h"
+#include "../DSP/IRHandOver.h"
+
+/**
+ * One thread pool shared by every IRFx instance in the process (hold it through a
+ * juce::SharedResourcePointer), sized to the machine's cores.
+ *
+ * On session open each instance queues its IRs here instead of loading them one by
+ * one in prepareToPlay: a job takes the decoded audio from the IRCache (decoding it
+ * there if needed), lets Convolution resample and build its FFT engine on the pool
+ * thread, and offers the finished engine to the instance's IRHandOver. Open time
+ * then scales with cores, not instance count.
+ */
+class IRRestorePool
+{
+public:
+    using Source = IRCache::Source;
+
+    IRRestorePool();
+
+    void restore(std::shared_ptr<IRHandOver> handOver, int irIndex, int generation,
+                 Source source, const juce::dsp::ProcessSpec& spec);
+
+    // Builds and prepares an engine for source, then hands it to onDone on the pool thread
+    // (nullptr if there was nothing to load, or isWanted said no by the time the job ran).
+    // Neither callback may capture the instance itself.
+    using EngineCallback = std::function<void(std::unique_ptr<juce::dsp::Convolution>)>;
+    void prepare(Source source, const juce::dsp::ProcessSpec& spec, EngineCallback onDone,
+                 std::function<bool()> isWanted = {});
+
+    // The engine every IR load uses: Stereo, Trim and Normalise on, prepared for spec.
+    // Trim finds nothing left to cut in cached audio. Blocks while it resamples and partitions.
+    static std::unique_ptr<juce::dsp::Convolution> makeEngine(const IRCache::Audio& audio, const juce::dsp::ProcessSpec& spec);
+
+    // An engine for the first numSamples of audio only, at the level makeEngine's full-length
+    // engine will have, so one can crossfade into the other. Quick to prepare however long the IR is.
+    static std::unique_ptr<juce::dsp::Convolution> makePreviewEngine(const IRCache::Audio& audio, int numSamples,
+                                                                     const juce::dsp::ProcessSpec& spec);
+
+    // An engine that outputs silence, for a slot to fade out to when its IR is unloaded. Tiny to prepare.
+    static std::unique_ptr<juce::dsp::Convolution> makeSilentEngine(const juce::dsp::ProcessSpec& spec);
+
+    int getNumPendingJobs() const { return pool.getNumJobs(); }
+
+private:
+    juce::SharedResourcePointer<IRCache> cache;
+    juce::ThreadPool pool;      // after cache: its jobs finish before the cache goes
+};
@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 19 Oct 2026 9:07:23am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+
+PresetLibrary::PresetLibrary()
+    : juce::Thread("IRFx preset library"), folder(getFolder())
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    stopThread(2000);
+}
+
+juce::File PresetLibrary::getFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("IRFx/Presets");
+}
+
+std::shared_ptr<const PresetLibrary::Index> PresetLibrary::getIndex() const
+{
+    const juce::ScopedLock sl (indexLock);
+    return index;
+}
+
+PresetLibrary::Index PresetLibrary::search(const juce::String& text, const juce::String& tag) const
+{
+    const auto words = juce::StringArray::fromTokens(text, true);
+    Index result;
+
+    for (const auto& preset : *getIndex())
+    {
+        if (tag.isNotEmpty() && ! preset->tags.contains(tag, true))
+            continue;
+
+        const bool matches = std::all_of(words.begin(), words.end(), [&preset] (const juce::String& word)
+        {
+            return preset->name.containsIgnoreCase(word)
+                || std::any_of(preset->tags.begin(), preset->tags.end(), [&word] (const juce::String& t) { return t.containsIgnoreCase(word); });
+        });
+
+        if (matches)
+            result.push_back(preset);
+    }
+    return result;
+}
+
+PresetLibrary::PresetPtr PresetLibrary::find(const juce::String& name) const
+{
+    for (const auto& preset : *getIndex())
+        if (preset->name == name)
+            return preset;
+    return nullptr;
+}
+
+juce::StringArray PresetLibrary::getTags() const
+{
+    juce::StringArray tags;
+    for (const auto& preset : *getIndex())
+        tags.addArray(preset->tags);
+
+    tags.removeDuplicates(true);
+    tags.sortNatural();
+    return tags;
+}
+
+PresetLibrary::PresetPtr PresetLibrary::add(const juce::File& file)
+{
+    auto preset = parse(file);
+    if (preset == nullptr)
+        return nullptr;
+
+    auto newIndex = std::make_shared<Index>();
+    for (const auto& existing : *getIndex())
+        if (existing->file != file)
+            newIndex->push_back(existing);
+
+    newIndex->push_back(preset);
+    std::sort(newIndex->begin(), newIndex->end(), [] (const PresetPtr& a, const PresetPtr& b) { return a->name.compareNatural(b->name) < 0; });
+
+    publish(std::move(newIndex), getSetlists());
+    return preset;
+}
+
+void PresetLibrary::run()
+{
+    while (! threadShouldExit())
+    {
+        scan();
+        wait(checkIntervalMs);
+    }
+}
+
+void PresetLibrary::scan()
+{
+    scanning = true;
+    folder.createDirectory();
+
+    std::map<juce::String, PresetPtr> known;
+    for (const auto& preset : *getIndex())
+        known[preset->file.getFullPathName()] = preset;
+
+    std::map<juce::String, SetlistPtr> knownSetlists;
+    for (const auto& setlist : *getSetlists())
+        knownSetlists[setlist->file.getFullPathName()] = setlist;
+
+    auto newIndex = std::make_shared<Index>();
+    auto newSetlists = std::make_shared<Setlists>();
+    bool changed = false;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(folder, true, "*.xml;*.setlist", juce::File::findFiles))
+    {
+        if (threadShouldExit())
+        {
+            scanning = false;
+            return;
+        }
+
+        const auto& file = entry.getFile();
+
+        if (file.hasFileExtension("setlist"))
+        {
+            const auto it = knownSetlists.find(file.getFullPathName());
+            if (it != knownSetlists.end() && it->second->modified == entry.getModificationTime())
+            {
+                newSetlists->push_back(it->second);
+                knownSetlists.erase(it);
+            }
+            else
+            {
+                newSetlists->push_back(parseSetlist(file));
+                changed = true;
+            }
+            continue;
+        }
+
+        const auto it = known.find(file.getFullPathName());
+
+        // Unchanged files keep their parsed state; only new or edited ones are read
+        if (it != known.end() && it->second->modified == entry.getModificationTime())
+        {
+            newIndex->push_back(it->second);
+            known.erase(it);
+        }
+        else if (auto preset = parse(file))
+        {
+            newIndex->push_back(std::move(preset));
+            changed = true;
+        }
+    }
+
+    // Anything left over was deleted or moved away
+    if (changed || ! known.empty() || ! knownSetlists.empty())
+    {
+        std::sort(newIndex->begin(), newIndex->end(), [] (const PresetPtr& a, const PresetPtr& b) { return a->name.compareNatural(b->name) < 0; });
+        std::sort(newSetlists->begin(), newSetlists->end(), [] (const SetlistPtr& a, const SetlistPtr& b) { return a->name.compareNatural(b->name) < 0; });
+        publish(std::move(newIndex), std::move(newSetlists));
+    }
+
+    scanning = false;
+}
+
+PresetLibrary::PresetPtr PresetLibrary::parse(const juce::File& file) const
+{
+    std::unique_ptr<juce::XmlElement> xml (juce::XmlDocument::parse(file));
+    if (xml == nullptr)
+        return nullptr;
+
+    auto preset = std::make_shared<Preset>();
+    preset->name = file.getFileNameWithoutExtension();
+    preset->file = file;
+    preset->modified = file.getLastModificationTime();
+    preset->state = juce::ValueTree::fromXml(*xml);
+
+    // Subfolders are tags, outermost first
+    if (file.getParentDirectory() != folder)
+        preset->tags.addTokens(file.getParentDirectory().getRelativePathFrom(folder), juce::File::getSeparatorString(), {});
+
+    preset->tags.addTokens(preset->state.getProperty("Tags").toString(), ",", "\"");
+    preset->tags.trim();
+    preset->tags.removeEmptyStrings();
+    preset->tags.removeDuplicates(true);
+    return preset;
+}
+
+PresetLibrary::SetlistPtr PresetLibrary::parseSetlist(const juce::File& file)
+{
+    auto setlist = std::make_shared<Setlist>();
+    setlist->name = file.getFileNameWithoutExtension();
+    setlist->file = file;
+    setlist->modified = file.getLastModificationTime();
+
+    // One preset name per line; blank lines and # comments are skipped
+    for (auto line : juce::StringArray::fromLines(file.loadFileAsString()))
+    {
+        line = line.trim();
+        if (line.isNotEmpty() && ! line.startsWithChar('#'))
+            setlist->presetNames.add(line);
+    }
+    return setlist;
+}
+
+PresetLibrary::Index PresetLibrary::getSetlistPresets(const Setlist& setlist) const
+{
+    Index result;
+    for (const auto& name : setlist.presetNames)
+        if (auto preset = find(name))
+            result.push_back(std::move(preset));
+    return result;
+}
+
+std::shared_ptr<const PresetLibrary::Setlists> PresetLibrary::getSetlists() const
+{
+    const juce::ScopedLock sl (indexLock);
+    return setlists;
+}
+
+void PresetLibrary::publish(std::shared_ptr<const Index> newIndex, std::shared_ptr<const Setlists> newSetlists)
+{
+    {
+        const juce::ScopedLock sl (indexLock);
+        index = std::move(newIndex);
+        setlists = std::move(newSetlists);
+    }
+    sendChangeMessage();
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 19 Oct 2026 9:07:23am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * In-memory index of every preset under the preset folder, shared by all IRFx
+ * instances in the process (hold it through a juce::SharedResourcePointer).
+ *
+ * A background thread scans the folder tree, parses each preset once and keeps
+ * the parsed state, so browsing and applying never touch the disk. The same
+ * thread watches the folder: it re-checks modification times every few seconds
+ * and only re-parses files that were added or changed. Listeners get a change
+ * message whenever the index changes.
+ *
+ * Tags come from the subfolders a preset sits in plus the preset's own "Tags"
+ * property (comma separated).
+ *
+ * A setlist is a .setlist text file anywhere under the folder: one preset name per
+ * line, in playing order.
+ */
+class PresetLibrary : public juce::ChangeBroadcaster,
+                      private juce::Thread
+{
+public:
+    struct Preset
+    {
+        juce::String name;
+        juce::File file;
+        juce::Time modified;
+        juce::ValueTree state;      // never modified once indexed; apply a copy
+        juce::StringArray tags;
+    };
+    using PresetPtr = std::shared_ptr<const Preset>;
+    using Index = std::vector<PresetPtr>;
+
+    struct Setlist
+    {
+        juce::String name;
+        juce::File file;
+        juce::Time modified;
+        juce::StringArray presetNames;
+    };
+    using SetlistPtr = std::shared_ptr<const Setlist>;
+    using Setlists = std::vector<SetlistPtr>;
+
+    PresetLibrary();
+    ~PresetLibrary() override;
+
+    static juce::File getFolder();
+
+    // Sorted by name. Cheap: a shared snapshot, safe to keep while the library rescans.
+    std::shared_ptr<const Index> getIndex() const;
+
+    // Presets whose name or tags contain every word of text; tag, if given, must match exactly
+    Index search(const juce::String& text, const juce::String& tag = {}) const;
+    PresetPtr find(const juce::String& name) const;
+    juce::StringArray getTags() const;
+
+    // Sorted by name
+    std::shared_ptr<const Setlists> getSetlists() const;
+    // The setlist's presets in its order; names with no preset are left out
+    Index getSetlistPresets(const Setlist& setlist) const;
+
+    // Indexes one file right away, e.g. a preset that was just saved. Any thread.
+    PresetPtr add(const juce::File& file);
+    // Wakes the scanner instead of waiting for the next check
+    void rescan() { notify(); }
+    bool isScanning() const { return scanning.load(); }
+
+private:
+    void run() override;
+    void scan();
+    PresetPtr parse(const juce::File& file) const;
+    static SetlistPtr parseSetlist(const juce::File& file);
+    void publish(std::shared_ptr<const Index> newIndex, std::shared_ptr<const Setlists> newSetlists);
+
+    static constexpr int checkIntervalMs = 3000;
+
+    const juce::File folder;
+    mutable juce::CriticalSection indexLock;
+    std::shared_ptr<const Index> index = std::make_shared<const Index>();
+    std::shared_ptr<const Setlists> setlists = std::make_shared<const Setlists>();
+    std::atomic<bool> scanning { false };
+};
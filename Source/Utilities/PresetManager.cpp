@@ -3,7 +3,19 @@
 PresetManager::PresetManager(IRFxAudioProcessor& processor, juce::ComboBox& presetBox) : audioProcessor(processor),
 presetBox(presetBox)
 {
-    
+    library->addChangeListener(this);
+}
+
+PresetManager::~PresetManager()
+{
+    library->removeChangeListener(this);
+}
+
+void PresetManager::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    // The open popup keeps showing the old list; items map to listed, which only changes here
+    if (! presetBox.isPopupActive())
+        refreshPresetList();
 }
 
 void PresetManager::savePreset()
@@ -26,7 +38,8 @@ void PresetManager::savePreset()
             audioProcessor.savePreset(selectedFile);
             DBG("Preset saved to: " + selectedFile.getFullPathName());
             
-            // Optionally, refresh the preset list in the UI or do other actions
+            // Indexed now rather than on the library's next check, so it can be selected right away
+            library->add(selectedFile);
             refreshPresetList();
 
             applyPresetSelection(selectedFile.getFileNameWithoutExtension());
@@ -41,45 +54,124 @@ void PresetManager::savePreset()
 
 void PresetManager::loadPreset()
 {
-    juce::FileChooser chooser ("Load Preset", juce::File::getSpecialLocation (juce::File::userDocumentsDirectory), "*.xml");
-
-    auto file = chooser.getResult();
-    audioProcessor.loadPreset (file);  // Calls your processor’s loadPreset
+    fileChooser = std::make_unique<juce::FileChooser> ("Load Preset", getPresetFolder(), "*.xml");
+    
+    auto fileChooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
     
-    applyPresetSelection(file.getFileNameWithoutExtension());
+    fileChooser->launchAsync (fileChooserFlags, [this] (const juce::FileChooser& fileChooser)
+    {
+        auto file = fileChooser.getResult();
+        if (! file.existsAsFile())
+            return;
+        
+        audioProcessor.loadPreset (file);  // Calls your processor’s loadPreset
+        applyPresetSelection(file.getFileNameWithoutExtension());
+    });
 }
 
 void PresetManager::presetSelected()
 {
     auto selectedId = presetBox.getSelectedId();
-    if (selectedId > 0)
+    if (selectedId > 0 && selectedId <= static_cast<int>(listed.size()))
     {
-        auto presetName = presetBox.getItemText(selectedId - 1);
-        auto presetFile = getPresetFolder().getChildFile(presetName + ".xml");
-        audioProcessor.loadPreset(presetFile);
-        applyPresetSelection(presetName);
+        // Parsed by the library already; nothing is read from disk here
+        auto preset = listed[static_cast<size_t>(selectedId - 1)];
+        audioProcessor.applyPreset(preset->state);
+        applyPresetSelection(preset->name);
+        prefetchNeighbours();
     }
+    else if (selectedId >= setlistIdBase)
+    {
+        const auto setlists = library->getSetlists();
+        const auto index = static_cast<size_t>(selectedId - setlistIdBase - 1);
+        activeSetlist = selectedId > setlistIdBase && index < setlists->size() ? (*setlists)[index]->name : juce::String();
+        refreshPresetList();
+    }
+    else if (selectedId == 0)
+    {
+        // Text typed into the box
+        setSearchText(presetBox.getText());
+        if (! listed.empty() && searchText.isNotEmpty())
+            presetBox.showPopup();
+    }
+}
+
+void PresetManager::setSearchText(const juce::String& text)
+{
+    searchText = text.trim();
+    refreshPresetList();
 }
 
 void PresetManager::refreshPresetList()
 {
-    presetBox.clear();
-    auto presetFolder = getPresetFolder();
-    presetFolder.createDirectory();
+    presetBox.clear(juce::dontSendNotification);
+    
+    const auto setlists = library->getSetlists();
+    const auto setlist = std::find_if(setlists->begin(), setlists->end(), [this] (const auto& s) { return s->name == activeSetlist; });
+    if (setlist == setlists->end())
+        activeSetlist = {};
+    
+    // A setlist shows its presets in playing order; otherwise the search results by name
+    listed = setlist != setlists->end() ? library->getSetlistPresets(**setlist) : library->search(searchText);
     
-    auto files = presetFolder.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false);
+    // Presets in subfolders go in a submenu per top-level folder
+    const auto presetFolder = getPresetFolder();
+    std::map<juce::String, juce::PopupMenu> folders;
+    auto* rootMenu = presetBox.getRootMenu();
     
     int index = 1;
-    for (auto& file : files)
+    for (const auto& preset : listed)
     {
-        presetBox.addItem(file.getFileNameWithoutExtension(), index);
+        const auto parent = preset->file.getParentDirectory();
+        if (activeSetlist.isNotEmpty() || parent == presetFolder || ! parent.isAChildOf(presetFolder))
+            rootMenu->addItem(index, preset->name);
+        else
+            folders[parent.getRelativePathFrom(presetFolder).upToFirstOccurrenceOf(juce::File::getSeparatorString(), false, false)].addItem(index, preset->name);
         ++index;
     }
+    
+    if (! folders.empty())
+        rootMenu->addSeparator();
+    for (auto& [name, menu] : folders)
+        rootMenu->addSubMenu(name, menu);
+    
+    if (! setlists->empty())
+    {
+        juce::PopupMenu setlistMenu;
+        setlistMenu.addItem(setlistIdBase, "All presets", true, activeSetlist.isEmpty());
+        for (size_t i = 0; i < setlists->size(); ++i)
+            setlistMenu.addItem(setlistIdBase + 1 + static_cast<int>(i), (*setlists)[i]->name, true, (*setlists)[i]->name == activeSetlist);
+        
+        rootMenu->addSeparator();
+        rootMenu->addSubMenu("Setlists", setlistMenu);
+    }
+    
+    if (auto id = getItemIdForText(presetBox, audioProcessor.getCurrentPresetName()); id != 0)
+        presetBox.setSelectedId(id, juce::dontSendNotification);
+    else
+        presetBox.setText(searchText, juce::dontSendNotification);
+    
+    prefetchNeighbours();
+}
+
+void PresetManager::prefetchNeighbours()
+{
+    const auto current = std::find_if(listed.begin(), listed.end(), [this] (const auto& preset) { return preset->name == audioProcessor.getCurrentPresetName(); });
+    const int position = current != listed.end() ? static_cast<int>(std::distance(listed.begin(), current)) : -1;
+    
+    // Next and previous first, then one further out each way; from the top if nothing is selected
+    std::vector<juce::ValueTree> neighbours;
+    for (int distance = 1; distance <= prefetchRadius; ++distance)
+        for (const int index : { position + distance, position - distance })
+            if (index >= 0 && index < static_cast<int>(listed.size()) && index != position)
+                neighbours.push_back(listed[static_cast<size_t>(index)]->state);
+    
+    audioProcessor.prefetchPresetIRs(neighbours);
 }
 
 juce::File PresetManager::getPresetFolder()
 {
-    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("IRFx/Presets");
+    return PresetLibrary::getFolder();
 }
 
 
@@ -87,7 +179,7 @@ int PresetManager::getItemIdForText(const juce::ComboBox& box, const juce::Strin
 {
     for (int i = 0; i < box.getNumItems(); ++i)
     {
-        if (box.getItemText(i) == textToFind)
+        if (box.getItemText(i) == textToFind && box.getItemId(i) < setlistIdBase)
             return box.getItemId(i);
     }
     return 0; // 0 means "not found"
@@ -96,5 +188,6 @@ int PresetManager::getItemIdForText(const juce::ComboBox& box, const juce::Strin
 void PresetManager::applyPresetSelection(const juce::String& presetName)
 {
     audioProcessor.setCurrentPresetName(presetName);
-    presetBox.setSelectedId(getItemIdForText(presetBox, presetName));
+    // No notification: that would apply the preset a second time
+    presetBox.setSelectedId(getItemIdForText(presetBox, presetName), juce::dontSendNotification);
 }
@@ -12,11 +12,16 @@
 
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
+#include "PresetLibrary.h"
 
-class PresetManager
+// Fills the preset box from the shared PresetLibrary and applies presets from memory.
+// Typing into the box filters the list by name and tag; picking a setlist shows just
+// its presets, in order. The IRs of the presets next to the current one are prefetched.
+class PresetManager : private juce::ChangeListener
 {
 public:
     PresetManager(IRFxAudioProcessor& processor, juce::ComboBox& presetBox);
+    ~PresetManager() override;
     
     void savePreset();
     void loadPreset();
@@ -24,11 +29,22 @@ public:
     void refreshPresetList();
     int getItemIdForText(const juce::ComboBox&, const juce::String&);
     void applyPresetSelection(const juce::String&);
+    void setSearchText(const juce::String&);
     
     
 private:
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    void prefetchNeighbours();
+    
+    static constexpr int setlistIdBase = 100000;   // "All presets", then one id per setlist
+    static constexpr int prefetchRadius = 2;
+    
     juce::File getPresetFolder();
     IRFxAudioProcessor& audioProcessor;
     juce::ComboBox& presetBox;
     std::unique_ptr<juce::FileChooser> fileChooser;
+    juce::SharedResourcePointer<PresetLibrary> library;
+    PresetLibrary::Index listed;    // item id - 1
+    juce::String searchText;
+    juce::String activeSetlist;
 };
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    PresetSwitcher.cpp
+    Created: 19 Oct 2026 9:11:51am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "PresetSwitcher.h"
+
+PresetSwitcher::PresetSwitcher(CommitFunction commitFunction) : commit(std::move(commitFunction))
+{
+}
+
+PresetSwitcher::~PresetSwitcher()
+{
+    stopTimer();
+}
+
+void PresetSwitcher::begin(std::shared_ptr<Transaction> transaction)
+{
+    // Counted before any job starts, so a fast job can't see zero early
+    for (auto change : transaction->irChanges)
+        if (change == IRChange::load)
+            ++transaction->pendingJobs;
+
+    const int current = ++*generation;
+
+    for (size_t slot = 0; slot < transaction->irChanges.size(); ++slot)
+    {
+        if (transaction->irChanges[slot] != IRChange::load)
+            continue;
+
+        // Each job keeps its transaction alive; one that got superseded is simply dropped
+        pool->prepare(transaction->irSources[slot], transaction->spec, [transaction, slot] (std::unique_ptr<juce::dsp::Convolution> engine)
+        {
+            transaction->engines[slot] = std::move(engine);
+            transaction->pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+        },
+        [generation = generation, current] { return generation->load() == current; });
+    }
+
+    pending = std::move(transaction);
+
+    if (commitIfReady())
+        startTimer(10);
+}
+
+bool PresetSwitcher::commitIfReady()
+{
+    if (pending == nullptr)
+        return false;
+
+    if (pending->pendingJobs.load(std::memory_order_acquire) > 0)
+        return true;
+
+    stopTimer();
+    const auto transaction = std::move(pending);
+    pending = nullptr;
+    commit(*transaction);
+    return false;
+}
+
+void PresetSwitcher::timerCallback()
+{
+    commitIfReady();
+}
+
+PresetSwitcher::BlockState PresetSwitcher::beginBlock()
+{
+    // Finished first: a commit that completes in between then still reads as "writing" for one block
+    const int finished = commitsFinished.load(std::memory_order_acquire);
+    const int started = commitsStarted.load();
+
+    BlockState state;
+    state.commitsFinished = finished;
+    state.morph = started != finished || finished != lastFinished;
+    lastFinished = finished;
+    return state;
+}
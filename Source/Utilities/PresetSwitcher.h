@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    PresetSwitcher.h
+    Created: 19 Oct 2026 9:11:51am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "IRArchive.h"
+#include "IRRestorePool.h"
+
+/**
+ * Applies a preset as a transaction, so switching mid-song is inaudible apart from
+ * the tone change itself:
+ *  1. begin(): the preset's new IRs are built on the shared IRRestorePool while the
+ *     current preset keeps playing untouched
+ *  2. once all of them are in, the commit function writes the state and offers the
+ *     engines on the message thread, between beginCommit() and endCommit()
+ *  3. the engines offered carry the commit's number, so the audio thread takes them
+ *     together in the first block that sees the commit finished; continuous parameters
+ *     ramp over the morph time meanwhile
+ *
+ * A newer begin() supersedes a transaction that is still preparing; its jobs not yet
+ * started then build nothing.
+ */
+class PresetSwitcher : private juce::Timer
+{
+public:
+    enum class IRChange
+    {
+        keep,
+        unload,
+        load
+    };
+
+    struct Transaction
+    {
+        juce::ValueTree state;              // a private copy, written as is
+        IRArchive::SlotEntries embedded;
+        std::array<IRChange, 2> irChanges { IRChange::keep, IRChange::keep };
+        std::array<IRRestorePool::Source, 2> irSources;
+        std::array<std::unique_ptr<juce::dsp::Convolution>, 2> engines;    // filled in on the pool
+        juce::dsp::ProcessSpec spec {};
+        std::atomic<int> pendingJobs { 0 };
+    };
+    using CommitFunction = std::function<void(Transaction&)>;
+
+    explicit PresetSwitcher(CommitFunction commitFunction);
+    ~PresetSwitcher() override;
+
+    //========================    MESSAGE THREAD    ========================
+    void begin(std::shared_ptr<Transaction> transaction);
+    // Commits the pending transaction now if its IRs are ready. True while one is still pending.
+    bool commitIfReady();
+    bool isPending() const { return pending != nullptr; }
+    // Drops the pending transaction; its jobs still queued are skipped, running ones thrown away
+    void cancel()           { stopTimer(); ++*generation; pending = nullptr; }
+
+    // Around the commit function's writes. beginCommit() returns the commit's number, for IRHandOver.
+    int beginCommit()   { return commitsStarted.fetch_add(1) + 1; }
+    void endCommit()    { commitsFinished.fetch_add(1, std::memory_order_release); }
+
+    //========================    ANY THREAD    ========================
+    void setMorphSeconds(float seconds) { morphSeconds.store(juce::jmax(0.f, seconds)); }
+    float getMorphSeconds() const       { return morphSeconds.load(); }
+
+    //========================    AUDIO THREAD    ========================
+    struct BlockState
+    {
+        bool morph = false;         // ramp parameter changes over the morph time
+        int commitsFinished = 0;    // engines from later commits are left waiting this block
+    };
+    BlockState beginBlock();
+
+private:
+    void timerCallback() override;
+
+    CommitFunction commit;
+    juce::SharedResourcePointer<IRRestorePool> pool;
+    std::shared_ptr<Transaction> pending;
+    // Bumped by begin() and cancel(); shared, as pool jobs can outlive the switcher
+    const std::shared_ptr<std::atomic<int>> generation = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> commitsStarted { 0 }, commitsFinished { 0 };
+    int lastFinished = 0;
+    std::atomic<float> morphSeconds { 0.25f };
+};
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 19 Oct 2026 8:39:37am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+#include <bit>
+
+namespace Profiling
+{
+    const char* getStageName(Stage stage)
+    {
+        switch (stage)
+        {
+            case inputGain:     return "Input gain";
+            case ir1:           return "IR1";
+            case ir2:           return "IR2";
+            case irEQ:          return "IR EQ";
+            case toneStack:     return "Tone stack";
+            case saturation:    return "Saturation";
+            case delay:         return "Delay";
+            case output:        return "Output";
+            case wholeBlock:    return "Whole block";
+            case numStages:     break;
+        }
+        return "";
+    }
+
+    double StageStats::percentileMicros(double fraction) const
+    {
+        const auto wanted = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count)));
+        uint64_t seen = 0;
+
+        for (int b = 0; b < numBuckets; ++b)
+        {
+            seen += histogram[static_cast<size_t>(b)];
+            if (seen >= wanted && seen > 0)
+                return b == numBuckets - 1 ? worstMicros : std::ldexp(1.0, firstBucketLog2 + b) * 1.0e-3;
+        }
+
+        return worstMicros;
+    }
+
+    void StageProfiler::record(Stage stage, juce::int64 ticks)
+    {
+        auto& c = counters[static_cast<size_t>(stage)];
+        const auto t = static_cast<uint64_t>(juce::jmax<juce::int64>(0, ticks));
+        blockTicks[static_cast<size_t>(stage)] += ticks;
+
+        bump(c.count);
+        bump(c.totalTicks, t);
+
+        if (t > c.worstTicks.load(std::memory_order_relaxed))
+            c.worstTicks.store(t, std::memory_order_relaxed);
+
+        const auto nanos = static_cast<uint64_t>(juce::Time::highResolutionTicksToSeconds(static_cast<juce::int64>(t)) * 1.0e9);
+        const int log2 = static_cast<int>(std::bit_width(nanos)) - 1;
+        bump(c.buckets[static_cast<size_t>(juce::jlimit(0, numBuckets - 1, log2 - firstBucketLog2 + 1))]);
+    }
+
+    StageStats StageProfiler::getStats(Stage stage) const
+    {
+        const auto& c = counters[static_cast<size_t>(stage)];
+        StageStats stats;
+
+        stats.count = c.count.load(std::memory_order_relaxed);
+        const auto total = c.totalTicks.load(std::memory_order_relaxed);
+        const auto worst = c.worstTicks.load(std::memory_order_relaxed);
+
+        if (stats.count > 0)
+            stats.meanMicros = juce::Time::highResolutionTicksToSeconds(static_cast<juce::int64>(total / stats.count)) * 1.0e6;
+        stats.worstMicros = juce::Time::highResolutionTicksToSeconds(static_cast<juce::int64>(worst)) * 1.0e6;
+
+        for (size_t b = 0; b < stats.histogram.size(); ++b)
+            stats.histogram[b] = c.buckets[b].load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    void StageProfiler::reset()
+    {
+        for (auto& c : counters)
+        {
+            c.count.store(0, std::memory_order_relaxed);
+            c.totalTicks.store(0, std::memory_order_relaxed);
+            c.worstTicks.store(0, std::memory_order_relaxed);
+            for (auto& bucket : c.buckets)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026 8:39:37am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-stage timing of processBlock, only in builds that define IRFX_ENABLE_PROFILING=1.
+// Otherwise IRFX_PROFILE_STAGE compiles to nothing and no profiler exists at all.
+#ifndef IRFX_ENABLE_PROFILING
+ #define IRFX_ENABLE_PROFILING 0
+#endif
+
+namespace Profiling
+{
+    enum Stage
+    {
+        inputGain = 0,
+        ir1,
+        ir2,
+        irEQ,
+        toneStack,
+        saturation,
+        delay,
+        output,
+        wholeBlock,
+        numStages
+    };
+
+    const char* getStageName(Stage stage);
+
+    // log2 buckets of nanoseconds: bucket 0 is < 512 ns, each next one doubles, the last is open-ended
+    constexpr int numBuckets = 24;
+    constexpr int firstBucketLog2 = 9;
+
+    struct StageStats
+    {
+        uint64_t count = 0;
+        double meanMicros = 0.0;
+        double worstMicros = 0.0;
+        std::array<uint64_t, numBuckets> histogram {};
+
+        // Upper edge of the bucket holding the given fraction of calls
+        double percentileMicros(double fraction) const;
+    };
+
+    /**
+     * Lock-free per-instance counters. Only the audio thread writes, so every
+     * update is a relaxed load/store pair rather than an atomic read-modify-write.
+     * Any thread may read; a reading taken mid-block can be one call behind.
+     */
+    class StageProfiler
+    {
+    public:
+        void record(Stage stage, juce::int64 ticks);
+        StageStats getStats(Stage stage) const;
+
+        // Audio thread only: per-stage ticks of the block in progress, for the deadline watchdog
+        void beginBlock() { blockTicks.fill(0); }
+        const std::array<juce::int64, numStages>& getBlockTicks() const { return blockTicks; }
+
+        // Called from the GUI; racing with the audio thread can lose at most one call per stage
+        void reset();
+
+        class ScopedTimer
+        {
+        public:
+            ScopedTimer(StageProfiler& p, Stage s) : profiler(p), stage(s), start(juce::Time::getHighResolutionTicks()) {}
+            ~ScopedTimer() { profiler.record(stage, juce::Time::getHighResolutionTicks() - start); }
+
+        private:
+            StageProfiler& profiler;
+            const Stage stage;
+            const juce::int64 start;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+        };
+
+    private:
+        struct Counters
+        {
+            std::atomic<uint64_t> count { 0 }, totalTicks { 0 }, worstTicks { 0 };
+            std::array<std::atomic<uint64_t>, numBuckets> buckets {};
+        };
+
+        static void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        std::array<Counters, numStages> counters;
+        std::array<juce::int64, numStages> blockTicks {};
+    };
+}
+
+#if IRFX_ENABLE_PROFILING
+ #define IRFX_PROFILE_STAGE(profiler, stage) \
+    const Profiling::StageProfiler::ScopedTimer JUCE_JOIN_MACRO (irfxStageTimer_, __LINE__) (profiler, Profiling::stage)
+#else
+ #define IRFX_PROFILE_STAGE(profiler, stage)
+#endif
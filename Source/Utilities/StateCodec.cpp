@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    StateCodec.cpp
+    Created: 19 Oct 2026 9:00:25am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "StateCodec.h"
+#include "../ParamRegistry.h"
+
+namespace
+{
+    constexpr int magic = 0x53465249;   // "IRFS", little-endian
+
+    // How juce::AudioProcessorValueTreeState lays out its parameter children
+    const juce::Identifier paramType ("PARAM");
+    const juce::Identifier idProperty ("id");
+    const juce::Identifier valueProperty ("value");
+    const juce::Identifier extrasType ("Extras");
+}
+
+//==============================================================================
+void StateCodec::write(const juce::ValueTree& state, juce::MemoryBlock& destData)
+{
+    destData.reset();
+    juce::MemoryOutputStream stream (destData, false);
+
+    stream.writeInt(magic);
+    stream.writeInt(formatVersion);
+
+    stream.writeInt(Params::numParams);
+    for (const auto& spec : Params::table)
+    {
+        const auto param = state.getChildWithProperty(idProperty, juce::String(spec.id));
+        stream.writeFloat(static_cast<float>(param.getProperty(valueProperty, spec.defaultValue)));
+    }
+
+    // Everything that isn't a parameter, in ValueTree's own binary form (keeps binary data raw)
+    juce::ValueTree extras (extrasType);
+    extras.copyPropertiesFrom(state, nullptr);
+
+    for (const auto& child : state)
+        if (! child.hasType(paramType))
+            extras.appendChild(child.createCopy(), nullptr);
+
+    extras.writeToStream(stream);
+}
+
+juce::ValueTree StateCodec::read(const void* data, int sizeInBytes, const juce::Identifier& stateType)
+{
+    juce::MemoryInputStream stream (data, static_cast<size_t>(juce::jmax(0, sizeInBytes)), false);
+
+    if (sizeInBytes < 12 || stream.readInt() != magic)
+    {
+        // Written by a version that still saved XML
+        if (const auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes); xml != nullptr && xml->hasTagName(stateType))
+            return juce::ValueTree::fromXml(*xml);
+        return {};
+    }
+
+    if (stream.readInt() > formatVersion)
+        return {};
+
+    juce::ValueTree state (stateType);
+
+    // Parameters added since the state was written keep their defaults
+    const int numStored = stream.readInt();
+    for (int i = 0; i < numStored && ! stream.isExhausted(); ++i)
+    {
+        const float value = stream.readFloat();
+        if (i >= Params::numParams)
+            continue;
+
+        juce::ValueTree param (paramType);
+        param.setProperty(idProperty, Params::getID(static_cast<Params::ID>(i)), nullptr);
+        param.setProperty(valueProperty, value, nullptr);
+        state.appendChild(param, nullptr);
+    }
+
+    const auto extras = juce::ValueTree::readFromStream(stream);
+    if (extras.isValid())
+    {
+        state.copyPropertiesFrom(extras, nullptr);
+        for (const auto& child : extras)
+            state.appendChild(child.createCopy(), nullptr);
+    }
+
+    return state;
+}
+
+//==============================================================================
+StateChangeTracker::StateChangeTracker(juce::AudioProcessorValueTreeState& stateToTrack)
+    : apvts(stateToTrack)
+{
+    for (auto* param : apvts.processor.getParameters())
+        param->addListener(this);
+
+    apvts.state.addListener(this);
+}
+
+StateChangeTracker::~StateChangeTracker()
+{
+    apvts.state.removeListener(this);
+
+    for (auto* param : apvts.processor.getParameters())
+        param->removeListener(this);
+}
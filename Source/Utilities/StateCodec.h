@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    StateCodec.h
+    Created: 19 Oct 2026 9:00:25am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The plugin's state blob: compact binary instead of XML.
+ *
+ *   int32   magic ("IRFS") and format version
+ *   int32   parameter count, then one float32 per parameter in Params::table order
+ *   tree    everything else in the state (properties, embedded IRs) as a binary ValueTree
+ *
+ * Reading falls back to the copyXmlToBinary blobs earlier versions wrote, so both
+ * decode to the same apvts-style ValueTree.
+ */
+namespace StateCodec
+{
+    constexpr int formatVersion = 1;
+
+    void write(const juce::ValueTree& state, juce::MemoryBlock& destData);
+
+    // An invalid tree if the data is neither format or belongs to another tree type
+    juce::ValueTree read(const void* data, int sizeInBytes, const juce::Identifier& stateType);
+}
+
+/**
+ * Raises a flag whenever something getStateInformation writes may have changed:
+ * any parameter (from any thread, including host automation on the audio thread)
+ * or any property or child of the apvts state. Starts out changed.
+ */
+class StateChangeTracker : private juce::AudioProcessorParameter::Listener,
+                           private juce::ValueTree::Listener
+{
+public:
+    explicit StateChangeTracker(juce::AudioProcessorValueTreeState& apvts);
+    ~StateChangeTracker() override;
+
+    void markChanged() { changed.store(true); }
+
+    // True once per change
+    bool consumeChange() { return changed.exchange(false); }
+
+private:
+    void parameterValueChanged(int, float) override { markChanged(); }
+    void parameterGestureChanged(int, bool) override {}
+
+    void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override { markChanged(); }
+    void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override { markChanged(); }
+    void valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree&, int) override { markChanged(); }
+    void valueTreeRedirected(juce::ValueTree&) override { markChanged(); }
+
+    // Listens on apvts.state itself, whose listeners carry over when replaceState reassigns it
+    juce::AudioProcessorValueTreeState& apvts;
+    std::atomic<bool> changed { true };
+};
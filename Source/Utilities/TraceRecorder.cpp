@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 19 Oct 2026 8:41:01am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+namespace
+{
+    std::atomic<int> nextInstanceNumber { 1 };
+}
+
+TraceRecorder::TraceRecorder() : juce::Thread("IRFx Trace Writer"), instanceNumber(nextInstanceNumber++)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    setEnabled(false);
+}
+
+const char* TraceRecorder::getEventName(Event event)
+{
+    switch (event)
+    {
+        case Event::processBlock:       return "processBlock";
+        case Event::irSwap:             return "irSwap";
+        case Event::coefficientUpdate:  return "coefficientUpdate";
+        case Event::oversizedBlock:     return "oversizedBlock";
+        case Event::transport:          return "transport";
+        case Event::tempo:              return "tempo";
+        case Event::deadlineOverrun:    return "deadlineOverrun";
+        case Event::numEvents:          break;
+    }
+    return "";
+}
+
+void TraceRecorder::requestDump(const char* reason)
+{
+    if (enabled.load(std::memory_order_relaxed))
+        pendingDumpReason.store(reason, std::memory_order_release);
+}
+
+void TraceRecorder::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled)
+    {
+        enabled.store(true);
+        startThread(juce::Thread::Priority::low);
+    }
+    else
+    {
+        enabled.store(false);
+        stopThread(2000);
+    }
+}
+
+juce::File TraceRecorder::getTraceFolder() const
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("IRFx/Traces");
+}
+
+juce::File TraceRecorder::getLastTraceFile() const
+{
+    const juce::ScopedLock lock(fileLock);
+    return lastTraceFile;
+}
+
+void TraceRecorder::run()
+{
+    // A struggling session overruns many blocks in a row; one file per burst is enough
+    constexpr juce::uint32 minMillisBetweenDumps = 5000;
+    juce::uint32 lastDumpMillis = 0;
+    bool hasDumped = false;
+
+    while (! threadShouldExit())
+    {
+        if (const char* reason = pendingDumpReason.exchange(nullptr, std::memory_order_acquire))
+        {
+            const auto now = juce::Time::getMillisecondCounter();
+            if (! hasDumped || now - lastDumpMillis >= minMillisBetweenDumps)
+            {
+                // Let the blocks right after the overrun land in the ring too
+                wait(250);
+                dumpNow(reason);
+                lastDumpMillis = now;
+                hasDumped = true;
+            }
+        }
+
+        wait(100);
+    }
+}
+
+std::vector<TraceRecorder::Record> TraceRecorder::copyRing() const
+{
+    const auto end = writeIndex.load(std::memory_order_acquire);
+    const auto count = juce::jmin<uint64_t>(end, ringSize);
+    const auto first = end - count;
+
+    std::vector<Record> records(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i)
+        records[static_cast<size_t>(i)] = ring[static_cast<size_t>((first + i) & (ringSize - 1))];
+
+    // Whatever the audio thread lapped while we were copying may be torn, so drop it. Record
+    // `after` may be being written right now, over the slot of record after - ringSize.
+    const auto after = writeIndex.load(std::memory_order_acquire);
+    const auto oldestIntact = after + 1 > ringSize ? after + 1 - ringSize : 0;
+    if (oldestIntact > first)
+        records.erase(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(juce::jmin(oldestIntact - first, count)));
+
+    return records;
+}
+
+juce::File TraceRecorder::dumpNow(const juce::String& reason)
+{
+    const auto records = copyRing();
+    if (records.empty())
+        return {};
+
+    const auto firstTicks = records.front().ticks;
+    const juce::String pid(instanceNumber);
+
+    juce::MemoryOutputStream json;
+    json << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"reason\":" << juce::JSON::toString(reason)
+         << ",\"instance\":" << pid << "},\"traceEvents\":[\n"
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":1,\"args\":{\"name\":\"Audio\"}}";
+
+    for (const auto& record : records)
+    {
+        const double micros = juce::Time::highResolutionTicksToSeconds(record.ticks - firstTicks) * 1.0e6;
+
+        json << ",\n{\"name\":\"" << getEventName(record.event) << "\",\"cat\":\"audio\",\"ts\":" << juce::String(micros, 3)
+             << ",\"pid\":" << pid << ",\"tid\":1,";
+
+        switch (record.phase)
+        {
+            case Phase::begin:      json << "\"ph\":\"B\"}"; break;
+            case Phase::end:        json << "\"ph\":\"E\"}"; break;
+            case Phase::instant:    json << "\"ph\":\"i\",\"s\":\"t\",\"args\":{\"value\":" << juce::String(record.value) << "}}"; break;
+        }
+    }
+
+    json << "\n]}\n";
+
+    auto folder = getTraceFolder();
+    if (! folder.exists() && ! folder.createDirectory())
+        return {};
+
+    const auto stamp = juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S");
+    auto file = folder.getNonexistentChildFile("IRFx-" + stamp + "-" + juce::File::createLegalFileName(reason), ".json", false);
+
+    if (! file.replaceWithData(json.getData(), json.getDataSize()))
+        return {};
+
+    const juce::ScopedLock lock(fileLock);
+    lastTraceFile = file;
+    return file;
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 19 Oct 2026 8:41:01am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Timeline of what the audio thread did, exportable as a Chrome-trace JSON file
+ * (opens in chrome://tracing or ui.perfetto.dev, no network involved).
+ *
+ * The audio thread writes fixed-size events into a per-instance overwrite ring,
+ * so the last few seconds are always available. A background thread, only
+ * running while tracing is on, turns the ring into a file when asked to, either
+ * on demand from the editor or when the audio thread flags a deadline overrun.
+ */
+class TraceRecorder : private juce::Thread
+{
+public:
+    enum class Event : uint8_t
+    {
+        processBlock,       // begin/end pair
+        irSwap,             // value = IR slot
+        coefficientUpdate,  // value = 0 IR EQ, 1 tone stack
+        oversizedBlock,     // value = samples; the host went over the prepared block size
+        transport,          // value = 1 playing / 0 stopped
+        tempo,              // value = bpm
+        deadlineOverrun,    // value = fraction of the block's time budget used
+        numEvents
+    };
+
+    enum class Phase : uint8_t { begin, end, instant };
+
+    struct Record
+    {
+        juce::int64 ticks;
+        float value;
+        Event event;
+        Phase phase;
+    };
+
+    static constexpr int ringSize = 1 << 14;    // a power of two; ~40 s of blocks at 48k/256
+
+    TraceRecorder();
+    ~TraceRecorder() override;
+
+    //========================    AUDIO THREAD    ========================
+    void begin(Event event)                         { add(event, Phase::begin, 0.f); }
+    void end(Event event)                           { add(event, Phase::end, 0.f); }
+    void instant(Event event, float value = 0.f)    { add(event, Phase::instant, value); }
+
+    // Wait-free: just sets a flag the writer thread picks up
+    void requestDump(const char* reason);
+
+    //========================    ANY OTHER THREAD    ========================
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled.load(); }
+
+    // Writes the ring synchronously on the calling thread, returns the file (or {} on failure)
+    juce::File dumpNow(const juce::String& reason);
+
+    juce::File getTraceFolder() const;
+    juce::File getLastTraceFile() const;
+
+    static const char* getEventName(Event event);
+
+private:
+    void add(Event event, Phase phase, float value)
+    {
+        if (! enabled.load(std::memory_order_relaxed))
+            return;
+
+        const auto index = writeIndex.load(std::memory_order_relaxed);
+        ring[static_cast<size_t>(index & (ringSize - 1))] = { juce::Time::getHighResolutionTicks(), value, event, phase };
+        writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    void run() override;
+    std::vector<Record> copyRing() const;
+
+    std::array<Record, ringSize> ring {};
+    std::atomic<uint64_t> writeIndex { 0 };
+    std::atomic<bool> enabled { false };
+
+    std::atomic<const char*> pendingDumpReason { nullptr };
+
+    const int instanceNumber;
+    mutable juce::CriticalSection fileLock;   // never taken on the audio thread
+    juce::File lastTraceFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TraceRecorder)
+};
@@ -0,0 +1,468 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 8:48:01am
+    Author:  Aaron Petrini
+
+    Microbenchmarks for every DSP stage and the whole processBlock, reported
+    as ns/sample over a grid of block sizes and sample rates. The JSON output
+    is meant to be kept per commit and diffed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/DSP/EqualPowerPan.h"
+#include "../../Common/TestSignals.h"
+
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: IRFxBench [options]\n"
+        "\n"
+        "  --output=<file.json>      write results there instead of stdout\n"
+        "  --label=<text>            stored with the results, e.g. the commit hash\n"
+        "  --filter=<text>           only cases whose name contains text\n"
+        "  --block-sizes=<a,b,...>   default 16,32,64,128,256,512,1024,2048\n"
+        "  --sample-rates=<a,b,...>  default 44100,48000,96000,192000\n"
+        "  --min-time=<seconds>      measuring time per case and config (default 0.1)\n"
+        "  --quick                   block sizes 64,256,1024 at 48000 only\n";
+
+    struct Config
+    {
+        double sampleRate;
+        int blockSize;
+    };
+
+    using BlockFunction = std::function<void(juce::AudioBuffer<float>&)>;
+
+    // Builds the stage for one config and returns what to run once per block
+    struct Case
+    {
+        juce::String name;
+        std::function<BlockFunction(const Config&)> prepare;
+    };
+
+    struct Measurement
+    {
+        double medianNsPerSample = 0.0;
+        double minNsPerSample = 0.0;
+        juce::int64 numBlocks = 0;
+    };
+
+    juce::dsp::ProcessSpec makeSpec(const Config& config, int numChannels = 2)
+    {
+        return { config.sampleRate, static_cast<juce::uint32>(config.blockSize), static_cast<juce::uint32>(numChannels) };
+    }
+
+    // Convolution engines are built on a background thread and installed from process()
+    template <typename IsReady>
+    bool processUntil(IsReady&& isReady, const BlockFunction& process, int blockSize)
+    {
+        juce::AudioBuffer<float> silence(2, blockSize);
+        const auto deadline = juce::Time::getMillisecondCounter() + 10000;
+
+        while (! isReady())
+        {
+            if (juce::Time::getMillisecondCounter() > deadline)
+                return false;
+
+            silence.clear();
+            process(silence);
+            juce::Thread::sleep(1);
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    Measurement measure(const BlockFunction& process, const Config& config, double minSeconds)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        // Fresh input every block so nothing decays into denormals or settles into a trivial case.
+        // The copy is part of every timing; the "baseline/copy" case shows how much it costs.
+        constexpr int noiseBlocks = 8;
+        juce::AudioBuffer<float> noise(2, config.blockSize * noiseBlocks);
+        juce::Random random(1);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+
+        juce::AudioBuffer<float> buffer(2, config.blockSize);
+        int noiseBlock = 0;
+
+        const auto runBlock = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, noise, ch, noiseBlock * config.blockSize, config.blockSize);
+            noiseBlock = (noiseBlock + 1) % noiseBlocks;
+            process(buffer);
+        };
+
+        // Warm caches, branch predictors and any lazy state
+        const int warmUpBlocks = juce::jmax(16, static_cast<int>(config.sampleRate * 0.05) / config.blockSize);
+        for (int i = 0; i < warmUpBlocks; ++i)
+            runBlock();
+
+        constexpr int numRuns = 5;
+        const auto ticksPerRun = juce::Time::secondsToHighResolutionTicks(minSeconds / numRuns);
+        std::array<double, numRuns> nsPerSample {};
+        Measurement result;
+
+        for (auto& run : nsPerSample)
+        {
+            juce::int64 blocks = 0, elapsed = 0;
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            do
+            {
+                runBlock();
+                ++blocks;
+                elapsed = juce::Time::getHighResolutionTicks() - start;
+            }
+            while (elapsed < ticksPerRun);
+
+            run = juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e9 / static_cast<double>(blocks * config.blockSize);
+            result.numBlocks += blocks;
+        }
+
+        std::sort(nsPerSample.begin(), nsPerSample.end());
+        result.medianNsPerSample = nsPerSample[numRuns / 2];
+        result.minNsPerSample = nsPerSample.front();
+        return result;
+    }
+
+    //==============================================================================
+    void addStageCases(std::vector<Case>& cases)
+    {
+        cases.push_back({ "baseline/copy", [] (const Config&) -> BlockFunction
+        {
+            return [] (juce::AudioBuffer<float>&) {};
+        }});
+
+        const std::array<const char*, 3> models { "neve", "ssl", "api" };
+        for (int model = 0; model < static_cast<int>(models.size()); ++model)
+        {
+            cases.push_back({ juce::String("saturation/") + models[static_cast<size_t>(model)], [model] (const Config& config) -> BlockFunction
+            {
+                auto saturation = std::make_shared<Saturation>();
+                saturation->prepare(makeSpec(config));
+                return [saturation, model] (juce::AudioBuffer<float>& buffer) { saturation->processBlock(buffer, 6.f, model, 1.f); };
+            }});
+        }
+
+        for (const auto mode : { DelayProcessor::Mode::Digital, DelayProcessor::Mode::Tape })
+        {
+            for (const bool isMono : { false, true })
+            {
+                const juce::String name = juce::String("delay/") + (mode == DelayProcessor::Mode::Digital ? "digital" : "tape")
+                                        + (isMono ? "/mono" : "/stereo");
+
+                cases.push_back({ name, [mode, isMono] (const Config& config) -> BlockFunction
+                {
+                    auto delay = std::make_shared<DelayProcessor>();
+                    delay->prepare(config.sampleRate, config.blockSize, 2);
+                    delay->setMode(mode);
+                    delay->setDelayTime(375.f);
+                    delay->setFeedback(50.f);
+                    delay->setMix(50.f);
+                    return [delay, isMono] (juce::AudioBuffer<float>& buffer) { delay->process(buffer, buffer.getNumSamples(), isMono); };
+                }});
+            }
+        }
+
+        cases.push_back({ "pan/equalPower", [] (const Config&) -> BlockFunction
+        {
+            return [] (juce::AudioBuffer<float>& buffer) { applyEqualPowerPan(buffer, 0.3f); };
+        }});
+
+        using Filter = juce::dsp::IIR::Filter<float>;
+        using Coefficients = juce::dsp::IIR::Coefficients<float>;
+
+        // Same chains and per-channel processing as IRFxAudioProcessor
+        cases.push_back({ "irEQ/chain", [] (const Config& config) -> BlockFunction
+        {
+            using Chain = juce::dsp::ProcessorChain<Filter, Filter>;
+            auto chains = std::make_shared<std::array<Chain, 2>>();
+
+            for (auto& chain : *chains)
+            {
+                chain.prepare(makeSpec(config, 1));
+                *chain.get<0>().coefficients = *Coefficients::makeHighPass(config.sampleRate, 80.f);
+                *chain.get<1>().coefficients = *Coefficients::makeLowPass(config.sampleRate, 8000.f);
+            }
+
+            return [chains] (juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                for (size_t ch = 0; ch < chains->size(); ++ch)
+                {
+                    auto channel = block.getSingleChannelBlock(ch);
+                    (*chains)[ch].process(juce::dsp::ProcessContextReplacing<float>(channel));
+                }
+            };
+        }});
+
+        cases.push_back({ "toneStack/chain", [] (const Config& config) -> BlockFunction
+        {
+            using Chain = juce::dsp::ProcessorChain<Filter, Filter, Filter>;
+            auto chains = std::make_shared<std::array<Chain, 2>>();
+            const float gain = juce::Decibels::decibelsToGain(3.f);
+
+            for (auto& chain : *chains)
+            {
+                chain.prepare(makeSpec(config, 1));
+                *chain.get<0>().coefficients = *Coefficients::makeLowShelf(config.sampleRate, 110.f, 0.707f, gain);
+                *chain.get<1>().coefficients = *Coefficients::makePeakFilter(config.sampleRate, 550.f, 1.f, gain);
+                *chain.get<2>().coefficients = *Coefficients::makeHighShelf(config.sampleRate, 4500.f, 0.707f, gain);
+            }
+
+            return [chains] (juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                for (size_t ch = 0; ch < chains->size(); ++ch)
+                {
+                    auto channel = block.getSingleChannelBlock(ch);
+                    (*chains)[ch].process(juce::dsp::ProcessContextReplacing<float>(channel));
+                }
+            };
+        }});
+
+        for (const int millis : { 25, 100, 500, 2000 })
+        {
+            cases.push_back({ "convolution/" + juce::String(millis) + "ms", [millis] (const Config& config) -> BlockFunction
+            {
+                auto convolution = std::make_shared<juce::dsp::Convolution>();
+                convolution->prepare(makeSpec(config));
+                convolution->loadImpulseResponse(TestSignals::makeImpulseResponse(config.sampleRate, millis * 0.001, millis),
+                                                 config.sampleRate,
+                                                 juce::dsp::Convolution::Stereo::yes,
+                                                 juce::dsp::Convolution::Trim::no,
+                                                 juce::dsp::Convolution::Normalise::yes);
+
+                BlockFunction process = [convolution] (juce::AudioBuffer<float>& buffer)
+                {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    convolution->process(juce::dsp::ProcessContextReplacing<float>(block));
+                };
+
+                if (! processUntil([&convolution] { return convolution->getCurrentIRSize() > 0; }, process, config.blockSize))
+                    return {};
+
+                return process;
+            }});
+        }
+    }
+
+    //==============================================================================
+    // The whole plugin, through the same entry point a host uses
+    void addProcessBlockCases(std::vector<Case>& cases, const juce::File& ir1File, const juce::File& ir2File)
+    {
+        const auto makeProcessor = [] (const Config& config, const juce::File& ir1, const juce::File& ir2) -> BlockFunction
+        {
+            auto processor = std::make_shared<IRFxAudioProcessor>();
+            processor->setPlayConfigDetails(2, 2, config.sampleRate, config.blockSize);
+
+            // Keep the watchdog's per-block cost in the numbers but never let it write a log
+            processor->watchdog.setThresholds({ 1.0e6f, 2.0e6f, 3.0e6f });
+
+            const auto set = [&processor] (Params::ID id, float value)
+            {
+                auto* param = processor->cachedParams[static_cast<size_t>(id)];
+                param->setValueNotifyingHost(param->convertTo0to1(value));
+            };
+
+            const bool everything = ir1 != juce::File();
+            if (everything)
+            {
+                // Every module doing audible work: both IRs, drive, delay
+                set(Params::ir1Pan, -30.f);
+                set(Params::ir2Pan, 30.f);
+                set(Params::eqMidGain, 3.f);
+                set(Params::distMix, 50.f);
+                set(Params::delayMix, 30.f);
+                processor->loadIR1(ir1);
+                processor->loadIR2(ir2);
+            }
+
+            processor->prepareToPlay(config.sampleRate, config.blockSize);
+
+            auto midi = std::make_shared<juce::MidiBuffer>();
+            BlockFunction process = [processor, midi] (juce::AudioBuffer<float>& buffer) { processor->processBlock(buffer, *midi); };
+
+            if (everything && ! processUntil([&processor]
+                                             {
+                                                 return processor->irLoader1->getCurrentIRSize() > 0
+                                                     && processor->irLoader2->getCurrentIRSize() > 0
+                                                     && ! processor->isRestoringIRs();
+                                             }, process, config.blockSize))
+                return {};
+
+            return process;
+        };
+
+        cases.push_back({ "processBlock/defaults", [makeProcessor] (const Config& config)
+        {
+            return makeProcessor(config, {}, {});
+        }});
+
+        cases.push_back({ "processBlock/dualIR-allModules", [makeProcessor, ir1File, ir2File] (const Config& config)
+        {
+            return makeProcessor(config, ir1File, ir2File);
+        }});
+    }
+
+    template <typename Type>
+    std::vector<Type> parseList(const juce::String& text)
+    {
+        std::vector<Type> values;
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+            if (token.trim().isNotEmpty())
+                values.push_back(static_cast<Type>(token.trim().getDoubleValue()));
+        return values;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    std::vector<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+    std::vector<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+
+    if (args.containsOption("--quick"))
+    {
+        blockSizes = { 64, 256, 1024 };
+        sampleRates = { 48000.0 };
+    }
+
+    if (const auto list = args.getValueForOption("--block-sizes"); list.isNotEmpty())
+        blockSizes = parseList<int>(list);
+    if (const auto list = args.getValueForOption("--sample-rates"); list.isNotEmpty())
+        sampleRates = parseList<double>(list);
+
+    const auto minTimeOption = args.getValueForOption("--min-time");
+    const double minSeconds = minTimeOption.isNotEmpty() ? minTimeOption.getDoubleValue() : 0.1;
+    const auto filter = args.getValueForOption("--filter");
+
+    const bool validGrid = ! blockSizes.empty() && ! sampleRates.empty()
+                        && std::all_of(blockSizes.begin(), blockSizes.end(), [] (int size) { return size >= 1 && size <= 8192; })
+                        && std::all_of(sampleRates.begin(), sampleRates.end(), [] (double rate) { return rate >= 8000.0 && rate <= 384000.0; });
+
+    if (! validGrid || minSeconds <= 0.0)
+    {
+        std::cerr << "IRFxBench: invalid block sizes, sample rates or --min-time\n\n" << usage;
+        return 1;
+    }
+
+    // processBlock loads IRs from disk like the plugin does
+    const auto tempFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("IRFxBench-" + juce::String(juce::Time::currentTimeMillis()));
+    const auto ir1File = tempFolder.getChildFile("ir1.wav");
+    const auto ir2File = tempFolder.getChildFile("ir2.wav");
+
+    if (! tempFolder.createDirectory() || ! TestSignals::writeImpulseResponse(ir1File, 0.1, 1) || ! TestSignals::writeImpulseResponse(ir2File, 0.1, 2))
+    {
+        std::cerr << "IRFxBench: cannot write test IRs to " << tempFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::vector<Case> cases;
+    addStageCases(cases);
+    addProcessBlockCases(cases, ir1File, ir2File);
+
+    juce::Array<juce::var> results;
+    int failures = 0;
+
+    for (const auto& benchCase : cases)
+    {
+        if (filter.isNotEmpty() && ! benchCase.name.contains(filter))
+            continue;
+
+        for (const auto sampleRate : sampleRates)
+        {
+            for (const auto blockSize : blockSizes)
+            {
+                const Config config { sampleRate, blockSize };
+                auto* entry = new juce::DynamicObject();
+                entry->setProperty("name", benchCase.name);
+                entry->setProperty("sampleRate", sampleRate);
+                entry->setProperty("blockSize", blockSize);
+
+                std::cerr << benchCase.name << " @ " << sampleRate << " Hz / " << blockSize << ": ";
+
+                if (auto process = benchCase.prepare(config))
+                {
+                    const auto m = measure(process, config, minSeconds);
+                    entry->setProperty("nsPerSample", m.medianNsPerSample);
+                    entry->setProperty("nsPerSampleMin", m.minNsPerSample);
+                    entry->setProperty("blocks", m.numBlocks);
+                    // Share of the real-time budget, 1.0 means the stage alone uses all of it
+                    entry->setProperty("realtimeLoad", m.medianNsPerSample * sampleRate * 1.0e-9);
+
+                    std::cerr << juce::String(m.medianNsPerSample, 2) << " ns/sample" << std::endl;
+                }
+                else
+                {
+                    entry->setProperty("error", "setup failed");
+                    ++failures;
+                    std::cerr << "setup failed" << std::endl;
+                }
+
+                results.add(juce::var(entry));
+            }
+        }
+    }
+
+    tempFolder.deleteRecursively();
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("tool", "IRFxBench");
+    root->setProperty("formatVersion", 1);
+    root->setProperty("label", args.getValueForOption("--label"));
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+   #if JUCE_DEBUG
+    root->setProperty("build", "debug");
+   #else
+    root->setProperty("build", "release");
+   #endif
+   #if IRFX_ENABLE_PROFILING
+    root->setProperty("profiling", true);
+   #endif
+    root->setProperty("minSecondsPerConfig", minSeconds);
+    root->setProperty("results", results);
+
+    const auto json = juce::JSON::toString(juce::var(root));
+
+    if (const auto output = args.getValueForOption("--output"); output.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(output);
+        if (! file.replaceWithText(json))
+        {
+            std::cerr << "IRFxBench: cannot write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    TestSignals.h
+    Created: 19 Oct 2026 8:53:09am
+    Author:  Aaron Petrini
+
+    Synthetic material shared by the command-line tools.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace TestSignals
+{
+    // Noise with an exponential decay to -60 dB, a stand-in for a cabinet IR
+    inline juce::AudioBuffer<float> makeImpulseResponse(double sampleRate, double seconds, int seed, int numChannels = 2)
+    {
+        const int length = juce::jmax(1, static_cast<int>(sampleRate * seconds));
+        juce::AudioBuffer<float> ir(numChannels, length);
+        juce::Random random(seed);
+
+        const double decayPerSample = std::log(0.001) / length;
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < length; ++i)
+                ir.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * static_cast<float>(std::exp(decayPerSample * i)));
+
+        return ir;
+    }
+
+    //==============================================================================
+    // Test material for the golden-output harness. Everything is generated at the rate
+    // being tested, on both channels, and is fully determined by its arguments.
+
+    // Exponential sine sweep at -6 dBFS
+    inline juce::AudioBuffer<float> makeLogSweep(double sampleRate, double seconds, double startHz = 20.0, double endHz = 20000.0)
+    {
+        const int length = static_cast<int>(sampleRate * seconds);
+        juce::AudioBuffer<float> sweep(2, length);
+
+        const double k = std::log(endHz / startHz);
+        for (int i = 0; i < length; ++i)
+        {
+            const double t = i / sampleRate;
+            const double phase = juce::MathConstants<double>::twoPi * startHz * seconds / k * (std::exp(t / seconds * k) - 1.0);
+            sweep.setSample(0, i, 0.5f * static_cast<float>(std::sin(phase)));
+        }
+
+        sweep.copyFrom(1, 0, sweep, 0, 0, length);
+        return sweep;
+    }
+
+    // Full-scale single-sample click, then silence
+    inline juce::AudioBuffer<float> makeImpulse(double sampleRate, double seconds)
+    {
+        juce::AudioBuffer<float> impulse(2, juce::jmax(1, static_cast<int>(sampleRate * seconds)));
+        impulse.clear();
+        impulse.setSample(0, 0, 1.f);
+        impulse.setSample(1, 0, 1.f);
+        return impulse;
+    }
+
+    // White noise at about -12 dBFS, different on each channel
+    inline juce::AudioBuffer<float> makeNoise(double sampleRate, double seconds, int seed)
+    {
+        const int length = static_cast<int>(sampleRate * seconds);
+        juce::AudioBuffer<float> noise(2, length);
+        juce::Random random(seed);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                noise.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+
+        return noise;
+    }
+
+    // Plucked-string (Karplus-Strong) riff with picked attacks: low E, A, a power chord, let ring.
+    // Not a real guitar, but it has the DI's crest factor, decays and low-end weight.
+    inline juce::AudioBuffer<float> makeGuitarDI(double sampleRate, double seconds, int seed)
+    {
+        struct Note { double startSeconds; double hz; float velocity; };
+        const Note notes[] { { 0.0, 82.41, 0.9f }, { 0.5, 110.0, 0.8f }, { 1.0, 82.41, 1.f }, { 1.0, 123.47, 0.9f }, { 1.0, 164.81, 0.8f } };
+
+        const int length = static_cast<int>(sampleRate * seconds);
+        juce::AudioBuffer<float> di(2, length);
+        di.clear();
+        juce::Random random(seed);
+
+        for (const auto& note : notes)
+        {
+            const int start = static_cast<int>(note.startSeconds * sampleRate);
+            const int period = juce::jmax(2, static_cast<int>(sampleRate / note.hz));
+            std::vector<float> string(static_cast<size_t>(period));
+            for (auto& sample : string)
+                sample = (random.nextFloat() * 2.f - 1.f) * note.velocity;
+
+            auto* out = di.getWritePointer(0);
+            for (int i = start, index = 0; i < length; ++i, index = (index + 1) % period)
+            {
+                const auto next = static_cast<size_t>((index + 1) % period);
+                const float value = string[static_cast<size_t>(index)];
+                out[i] += 0.25f * value;
+                string[static_cast<size_t>(index)] = 0.996f * 0.5f * (value + string[next]);
+            }
+        }
+
+        di.copyFrom(1, 0, di, 0, 0, length);
+        return di;
+    }
+
+    inline bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate, int bitDepth = 24)
+    {
+        file.deleteFile();
+        auto stream = file.createOutputStream();
+        if (stream == nullptr)
+            return false;
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+                                                                            static_cast<unsigned int>(audio.getNumChannels()),
+                                                                            bitDepth, {}, 0));
+        if (writer == nullptr)
+            return false;
+
+        stream.release();   // owned by the writer now
+        return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+
+    inline bool writeImpulseResponse(const juce::File& file, double seconds, int seed, int numChannels = 2, double sampleRate = 48000.0)
+    {
+        return writeWav(file, makeImpulseResponse(sampleRate, seconds, seed, numChannels), sampleRate);
+    }
+}
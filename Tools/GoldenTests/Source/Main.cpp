@@ -0,0 +1,516 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 8:55:25am
+    Author:  Aaron Petrini
+
+    Golden-output regression harness. --record renders fixed test signals
+    through each stage and the whole chain into a reference folder; --verify
+    renders them again and compares, reporting max error, RMS error and null
+    depth against per-stage tolerances. Record on the commit you trust, verify
+    on the one with the optimisation.
+
+    The references live in Tools/GoldenTests/References. record-references.sh
+    records them by building this file against the pre-series processor, so
+    fullChain only touches what both processors have: the apvts, the two
+    loaders and loadIR1/2. CMake builds default --references to that folder
+    and run --verify as a test.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../Common/TestSignals.h"
+
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: IRFxGolden --record|--verify [--references=<folder>] [options]\n"
+        "\n"
+        "  --record            render and store reference outputs\n"
+        "  --verify            render and compare against the stored references\n"
+        "  --references=<dir>  where references live (one 32-bit float WAV per case);\n"
+        "                      defaults to Tools/GoldenTests/References in CMake builds\n"
+        "  --filter=<text>     only stages whose name contains text\n"
+        "  --report=<file>     also write the comparison as JSON\n";
+
+    struct Config
+    {
+        double sampleRate;
+        int blockSize;
+    };
+
+    // Tiny blocks, a typical session, and a high-rate big-buffer setup
+    const Config configs[] { { 44100.0, 32 }, { 48000.0, 256 }, { 96000.0, 1024 } };
+
+    using BlockFunction = std::function<void(juce::AudioBuffer<float>&)>;
+
+    /**
+     * How far a stage may drift from its reference. Null depth is the error's RMS
+     * relative to the reference's RMS; max error is absolute, in dBFS. The bounds are
+     * loose enough for reordered float maths and tight enough to catch a real change.
+     */
+    struct Tolerance
+    {
+        double maxNullDepthDb;
+        double maxErrorDb;
+    };
+
+    struct Stage
+    {
+        juce::String name;
+        Tolerance tolerance;
+        double tailSeconds;
+        std::function<BlockFunction(const Config&)> prepare;
+    };
+
+    struct Signal
+    {
+        juce::String name;
+        std::function<juce::AudioBuffer<float>(double sampleRate)> make;
+    };
+
+    struct Comparison
+    {
+        double maxErrorDb = -300.0, rmsErrorDb = -300.0, nullDepthDb = -300.0;
+        bool lengthMatches = true;
+    };
+
+    juce::dsp::ProcessSpec makeSpec(const Config& config, int numChannels = 2)
+    {
+        return { config.sampleRate, static_cast<juce::uint32>(config.blockSize), static_cast<juce::uint32>(numChannels) };
+    }
+
+    double toDb(double value) { return juce::jmax(-300.0, 20.0 * std::log10(juce::jmax(value, 1.0e-15))); }
+
+    //==============================================================================
+    std::vector<Signal> makeSignals()
+    {
+        return {
+            { "sweep",    [] (double rate) { return TestSignals::makeLogSweep(rate, 2.0); } },
+            { "impulse",  [] (double rate) { return TestSignals::makeImpulse(rate, 0.05); } },
+            { "noise",    [] (double rate) { return TestSignals::makeNoise(rate, 1.0, 7); } },
+            { "guitarDI", [] (double rate) { return TestSignals::makeGuitarDI(rate, 2.5, 3); } },
+        };
+    }
+
+    // Convolution swaps its engine in from a background thread; feed silence until it has
+    bool waitFor(const std::function<bool()>& isReady, const BlockFunction& process, int blockSize)
+    {
+        juce::AudioBuffer<float> silence(2, blockSize);
+        const auto deadline = juce::Time::getMillisecondCounter() + 10000;
+
+        while (! isReady())
+        {
+            if (juce::Time::getMillisecondCounter() > deadline)
+                return false;
+
+            silence.clear();
+            process(silence);
+            juce::Thread::sleep(1);
+        }
+
+        return true;
+    }
+
+    // The pre-series processor has no restore to wait for
+    template <typename Processor>
+    bool isRestoringIRs(const Processor& processor)
+    {
+        if constexpr (requires { processor.isRestoringIRs(); })
+            return processor.isRestoringIRs();
+        else
+            return false;
+    }
+
+    std::vector<Stage> makeStages(const juce::File& ir1File, const juce::File& ir2File)
+    {
+        std::vector<Stage> stages;
+        using Filter = juce::dsp::IIR::Filter<float>;
+        using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+        const std::array<const char*, 3> models { "neve", "ssl", "api" };
+        for (int model = 0; model < static_cast<int>(models.size()); ++model)
+        {
+            stages.push_back({ juce::String("saturation-") + models[static_cast<size_t>(model)], { -80.0, -60.0 }, 0.0,
+                               [model] (const Config& config) -> BlockFunction
+            {
+                auto saturation = std::make_shared<Saturation>();
+                saturation->prepare(makeSpec(config));
+                return [saturation, model] (juce::AudioBuffer<float>& buffer) { saturation->processBlock(buffer, 8.f, model, 1.f); };
+            }});
+        }
+
+        for (const auto mode : { DelayProcessor::Mode::Digital, DelayProcessor::Mode::Tape })
+        {
+            stages.push_back({ mode == DelayProcessor::Mode::Digital ? "delay-digital" : "delay-tape", { -90.0, -70.0 }, 1.5,
+                               [mode] (const Config& config) -> BlockFunction
+            {
+                auto delay = std::make_shared<DelayProcessor>();
+                delay->prepare(config.sampleRate, config.blockSize, 2);
+                delay->setMode(mode);
+                delay->setDelayTime(250.f);
+                delay->setFeedback(50.f);
+                delay->setMix(50.f);
+                return [delay] (juce::AudioBuffer<float>& buffer) { delay->process(buffer, buffer.getNumSamples(), false); };
+            }});
+        }
+
+        stages.push_back({ "irEQ", { -100.0, -80.0 }, 0.1, [] (const Config& config) -> BlockFunction
+        {
+            using Chain = juce::dsp::ProcessorChain<Filter, Filter>;
+            auto chains = std::make_shared<std::array<Chain, 2>>();
+
+            for (auto& chain : *chains)
+            {
+                chain.prepare(makeSpec(config, 1));
+                *chain.get<0>().coefficients = ArrayCoefficients::makeHighPass(config.sampleRate, 80.f);
+                *chain.get<1>().coefficients = ArrayCoefficients::makeLowPass(config.sampleRate, 8000.f);
+                chain.reset();
+            }
+
+            return [chains] (juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                for (size_t ch = 0; ch < chains->size(); ++ch)
+                {
+                    auto channel = block.getSingleChannelBlock(ch);
+                    (*chains)[ch].process(juce::dsp::ProcessContextReplacing<float>(channel));
+                }
+            };
+        }});
+
+        stages.push_back({ "toneStack", { -100.0, -80.0 }, 0.1, [] (const Config& config) -> BlockFunction
+        {
+            using Chain = juce::dsp::ProcessorChain<Filter, Filter, Filter>;
+            auto chains = std::make_shared<std::array<Chain, 2>>();
+
+            for (auto& chain : *chains)
+            {
+                chain.prepare(makeSpec(config, 1));
+                *chain.get<0>().coefficients = ArrayCoefficients::makeLowShelf(config.sampleRate, 110.f, 0.707f, juce::Decibels::decibelsToGain(4.f));
+                *chain.get<1>().coefficients = ArrayCoefficients::makePeakFilter(config.sampleRate, 800.f, 1.f, juce::Decibels::decibelsToGain(-6.f));
+                *chain.get<2>().coefficients = ArrayCoefficients::makeHighShelf(config.sampleRate, 4500.f, 0.707f, juce::Decibels::decibelsToGain(3.f));
+                chain.reset();
+            }
+
+            return [chains] (juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                for (size_t ch = 0; ch < chains->size(); ++ch)
+                {
+                    auto channel = block.getSingleChannelBlock(ch);
+                    (*chains)[ch].process(juce::dsp::ProcessContextReplacing<float>(channel));
+                }
+            };
+        }});
+
+        stages.push_back({ "convolution", { -80.0, -60.0 }, 0.3, [] (const Config& config) -> BlockFunction
+        {
+            auto convolution = std::make_shared<juce::dsp::Convolution>();
+            convolution->prepare(makeSpec(config));
+            convolution->loadImpulseResponse(TestSignals::makeImpulseResponse(config.sampleRate, 0.2, 11),
+                                             config.sampleRate,
+                                             juce::dsp::Convolution::Stereo::yes,
+                                             juce::dsp::Convolution::Trim::no,
+                                             juce::dsp::Convolution::Normalise::yes);
+
+            BlockFunction process = [convolution] (juce::AudioBuffer<float>& buffer)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                convolution->process(juce::dsp::ProcessContextReplacing<float>(block));
+            };
+
+            if (! waitFor([convolution] { return convolution->getCurrentIRSize() > 0; }, process, config.blockSize))
+                return {};
+
+            // Past the crossfade into the new IR, then start from silence
+            for (int done = 0; done < static_cast<int>(config.sampleRate * 0.25); done += config.blockSize)
+            {
+                juce::AudioBuffer<float> silence(2, config.blockSize);
+                silence.clear();
+                process(silence);
+            }
+            convolution->reset();
+            return process;
+        }});
+
+        // The whole plugin with both IRs and every module doing something
+        stages.push_back({ "fullChain", { -70.0, -50.0 }, 1.5, [ir1File, ir2File] (const Config& config) -> BlockFunction
+        {
+            auto processor = std::make_shared<IRFxAudioProcessor>();
+            processor->setNonRealtime(true);
+            processor->setPlayConfigDetails(2, 2, config.sampleRate, config.blockSize);
+
+            // By ID string, which has not changed since the pre-series processor
+            const auto set = [&processor] (const char* id, float value)
+            {
+                auto* param = processor->apvts.getParameter(id);
+                param->setValueNotifyingHost(param->convertTo0to1(value));
+            };
+
+            set("InGain", 3.f);
+            set("IR1Pan", -40.f);
+            set("IR2Pan", 40.f);
+            set("IRLowCut", 70.f);
+            set("IRHighCut", 9000.f);
+            set("EQLowGain", 3.f);
+            set("EQMidGain", -4.f);
+            set("EQHighGain", 2.f);
+            set("DistDrive", 8.f);
+            set("DistMix", 60.f);
+            set("DelayMix", 25.f);
+            set("DelayTime", 250.f);
+            set("OutGain", -3.f);
+
+            processor->loadIR1(ir1File);
+            processor->loadIR2(ir2File);
+            processor->prepareToPlay(config.sampleRate, config.blockSize);
+
+            auto midi = std::make_shared<juce::MidiBuffer>();
+            BlockFunction process = [processor, midi] (juce::AudioBuffer<float>& buffer) { processor->processBlock(buffer, *midi); };
+
+            if (! waitFor([processor] { return processor->irLoader1->getCurrentIRSize() > 0 && processor->irLoader2->getCurrentIRSize() > 0
+                                       && ! isRestoringIRs(*processor); },
+                          process, config.blockSize))
+                return {};
+
+            for (int done = 0; done < static_cast<int>(config.sampleRate * 0.25); done += config.blockSize)
+            {
+                juce::AudioBuffer<float> silence(2, config.blockSize);
+                silence.clear();
+                process(silence);
+            }
+            processor->reset();
+            return process;
+        }});
+
+        return stages;
+    }
+
+    //==============================================================================
+    juce::AudioBuffer<float> render(const BlockFunction& process, const juce::AudioBuffer<float>& input,
+                                    const Config& config, double tailSeconds)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const int numSamples = input.getNumSamples() + static_cast<int>(tailSeconds * config.sampleRate);
+        juce::AudioBuffer<float> output(2, numSamples);
+        output.clear();
+        output.copyFrom(0, 0, input, 0, 0, input.getNumSamples());
+        output.copyFrom(1, 0, input, 1, 0, input.getNumSamples());
+
+        juce::AudioBuffer<float> block(2, config.blockSize);
+        for (int pos = 0; pos < numSamples; pos += config.blockSize)
+        {
+            const int length = juce::jmin(config.blockSize, numSamples - pos);
+            block.setSize(2, length, false, false, true);
+            for (int ch = 0; ch < 2; ++ch)
+                block.copyFrom(ch, 0, output, ch, pos, length);
+
+            process(block);
+
+            for (int ch = 0; ch < 2; ++ch)
+                output.copyFrom(ch, pos, block, ch, 0, length);
+        }
+
+        return output;
+    }
+
+    Comparison compare(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& output)
+    {
+        Comparison result;
+        result.lengthMatches = reference.getNumSamples() == output.getNumSamples()
+                            && reference.getNumChannels() == output.getNumChannels();
+        if (! result.lengthMatches)
+            return result;
+
+        double maxError = 0.0, errorEnergy = 0.0, referenceEnergy = 0.0;
+        for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+        {
+            const auto* ref = reference.getReadPointer(ch);
+            const auto* out = output.getReadPointer(ch);
+
+            for (int i = 0; i < reference.getNumSamples(); ++i)
+            {
+                const double error = static_cast<double>(out[i]) - static_cast<double>(ref[i]);
+                // NaN must never pass as "no error"
+                maxError = std::isfinite(error) ? juce::jmax(maxError, std::abs(error)) : 1.0e9;
+                errorEnergy += std::isfinite(error) ? error * error : 1.0e18;
+                referenceEnergy += static_cast<double>(ref[i]) * ref[i];
+            }
+        }
+
+        const double count = static_cast<double>(reference.getNumSamples() * reference.getNumChannels());
+        result.maxErrorDb = toDb(maxError);
+        result.rmsErrorDb = toDb(std::sqrt(errorEnergy / count));
+        result.nullDepthDb = referenceEnergy > 0.0 ? toDb(std::sqrt(errorEnergy / referenceEnergy)) : result.rmsErrorDb;
+        return result;
+    }
+
+    juce::AudioBuffer<float> readWav(const juce::File& file)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+        if (reader == nullptr)
+            return {};
+
+        juce::AudioBuffer<float> audio(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+        return audio;
+    }
+
+    juce::String caseName(const Stage& stage, const Signal& signal, const Config& config)
+    {
+        return stage.name + "/" + signal.name + "@" + juce::String(static_cast<int>(config.sampleRate)) + "-" + juce::String(config.blockSize);
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const bool recording = args.containsOption("--record");
+    const bool verifying = args.containsOption("--verify");
+    auto referencesOption = args.getValueForOption("--references");
+   #ifdef IRFX_GOLDEN_REFERENCES
+    if (referencesOption.isEmpty())
+        referencesOption = IRFX_GOLDEN_REFERENCES;
+   #endif
+
+    if (args.containsOption("--help|-h") || recording == verifying || referencesOption.isEmpty())
+    {
+        std::cout << usage;
+        return args.containsOption("--help|-h") ? 0 : 1;
+    }
+
+    const auto references = juce::File::getCurrentWorkingDirectory().getChildFile(referencesOption);
+    if (recording && ! references.createDirectory())
+    {
+        std::cerr << "IRFxGolden: cannot create " << references.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (verifying && references.findChildFiles(juce::File::findFiles, false, "*.wav").isEmpty())
+    {
+        std::cerr << "IRFxGolden: no references in " << references.getFullPathName()
+                  << "; record them with Tools/GoldenTests/record-references.sh" << std::endl;
+        return 1;
+    }
+
+    // IRs are part of the fixture: regenerated bit-identically on every run
+    const auto tempFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("IRFxGolden-" + juce::String(juce::Time::currentTimeMillis()));
+    const auto ir1File = tempFolder.getChildFile("ir1.wav");
+    const auto ir2File = tempFolder.getChildFile("ir2.wav");
+
+    if (! tempFolder.createDirectory() || ! TestSignals::writeImpulseResponse(ir1File, 0.15, 21)
+        || ! TestSignals::writeImpulseResponse(ir2File, 0.08, 22))
+    {
+        std::cerr << "IRFxGolden: cannot write test IRs" << std::endl;
+        return 1;
+    }
+
+    const auto filter = args.getValueForOption("--filter");
+    const auto stages = makeStages(ir1File, ir2File);
+    const auto signals = makeSignals();
+
+    juce::Array<juce::var> results;
+    int failures = 0, cases = 0;
+
+    for (const auto& stage : stages)
+    {
+        if (filter.isNotEmpty() && ! stage.name.contains(filter))
+            continue;
+
+        for (const auto& config : configs)
+        {
+            for (const auto& signal : signals)
+            {
+                const auto name = caseName(stage, signal, config);
+                const auto referenceFile = references.getChildFile(name.replaceCharacters("/@", "__") + ".wav");
+                ++cases;
+
+                // A fresh stage per signal, so each render starts from the same state
+                const auto process = stage.prepare(config);
+                if (! process)
+                {
+                    std::cout << "  ERROR  " << name << ": stage setup failed" << std::endl;
+                    ++failures;
+                    continue;
+                }
+
+                const auto output = render(process, signal.make(config.sampleRate), config, stage.tailSeconds);
+
+                if (recording)
+                {
+                    if (! TestSignals::writeWav(referenceFile, output, config.sampleRate, 32))
+                    {
+                        std::cout << "  ERROR  " << name << ": cannot write " << referenceFile.getFullPathName() << std::endl;
+                        ++failures;
+                    }
+                    continue;
+                }
+
+                const auto reference = readWav(referenceFile);
+                if (reference.getNumSamples() == 0)
+                {
+                    std::cout << "  MISSING " << name << " (record references first)" << std::endl;
+                    ++failures;
+                    continue;
+                }
+
+                const auto c = compare(reference, output);
+                const bool passed = c.lengthMatches
+                                 && c.nullDepthDb <= stage.tolerance.maxNullDepthDb
+                                 && c.maxErrorDb <= stage.tolerance.maxErrorDb;
+                failures += passed ? 0 : 1;
+
+                std::cout << (passed ? "  ok     " : "  FAIL   ") << name.paddedRight(' ', 40);
+                if (c.lengthMatches)
+                    std::cout << " null " << juce::String(c.nullDepthDb, 1) << " dB (<= " << stage.tolerance.maxNullDepthDb
+                              << "), max " << juce::String(c.maxErrorDb, 1) << " dBFS (<= " << stage.tolerance.maxErrorDb
+                              << "), rms " << juce::String(c.rmsErrorDb, 1) << " dBFS";
+                else
+                    std::cout << " length or channel count differs from the reference";
+                std::cout << std::endl;
+
+                auto* entry = new juce::DynamicObject();
+                entry->setProperty("case", name);
+                entry->setProperty("passed", passed);
+                entry->setProperty("nullDepthDb", c.nullDepthDb);
+                entry->setProperty("maxErrorDb", c.maxErrorDb);
+                entry->setProperty("rmsErrorDb", c.rmsErrorDb);
+                entry->setProperty("toleranceNullDepthDb", stage.tolerance.maxNullDepthDb);
+                entry->setProperty("toleranceMaxErrorDb", stage.tolerance.maxErrorDb);
+                results.add(juce::var(entry));
+            }
+        }
+    }
+
+    tempFolder.deleteRecursively();
+
+    if (recording)
+    {
+        std::cout << "Recorded " << (cases - failures) << " reference(s) in " << references.getFullPathName() << std::endl;
+        return failures > 0 ? 1 : 0;
+    }
+
+    if (const auto reportOption = args.getValueForOption("--report"); reportOption.isNotEmpty())
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("cases", cases);
+        root->setProperty("failures", failures);
+        root->setProperty("results", results);
+        juce::File::getCurrentWorkingDirectory().getChildFile(reportOption).replaceWithText(juce::JSON::toString(juce::var(root)));
+    }
+
+    std::cout << "\n" << (cases - failures) << "/" << cases << " within tolerance: " << (failures == 0 ? "PASS" : "FAIL") << std::endl;
+    return failures > 0 ? 1 : 0;
+}
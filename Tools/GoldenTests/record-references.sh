@@ -0,0 +1,30 @@
+#!/bin/sh
+# Records the golden references from the processor as it was before the optimisation series, into
+# Tools/GoldenTests/References, to be committed.
+#   IRFX_JUCE_DIR=/path/to/JUCE Tools/GoldenTests/record-references.sh [commit]
+# commit defaults to the baseline. It has no CMake build and an older processor, so it is checked
+# out next to this tree, the current harness is staged into it, and this tree's CMakeLists.txt
+# builds the two together as IRFxGoldenBaseline. That target includes the baseline editor, so the
+# usual JUCE Linux GUI dev packages are needed here, unlike for the other tools.
+set -e
+
+here="$(cd "$(dirname "$0")" && pwd)"
+root="$(git -C "$here" rev-parse --show-toplevel)"
+commit="${1:-8909a744b55fbe307bcf718b39c118c8ba3aba41}"
+juce="${IRFX_JUCE_DIR:-$root/../Project13/JUCE}"
+
+work="$(mktemp -d)"
+trap 'git -C "$root" worktree remove --force "$work/tree" 2>/dev/null; rm -rf "$work"' EXIT
+
+git -C "$root" worktree add --detach "$work/tree" "$commit"
+mkdir -p "$work/tree/Tools/GoldenTests"
+cp -R "$root/Tools/Common" "$work/tree/Tools/"
+cp -R "$here/Source" "$work/tree/Tools/GoldenTests/"
+
+cmake -S "$root" -B "$work/build" -DCMAKE_BUILD_TYPE=Release -DIRFX_BUILD_PLUGIN=OFF -DIRFX_JUCE_DIR="$juce" \
+      -DIRFX_GOLDEN_BASELINE_TREE="$work/tree"
+cmake --build "$work/build" --target IRFxGoldenBaseline -j"$(nproc)"
+
+rm -rf "$here/References"
+"$(find "$work/build" -type f -name IRFxGoldenBaseline -perm -u+x | head -n 1)" --record --references="$here/References"
+echo "Recorded on $commit; commit $here/References"
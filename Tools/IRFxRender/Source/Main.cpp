@@ -0,0 +1,513 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 8:46:23am
+    Author:  Aaron Petrini
+
+    Offline batch renderer: runs WAV files through the IRFx chain without a
+    host or an editor, one processor instance per worker thread.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: IRFxRender [options] <file.wav | folder> ...\n"
+        "\n"
+        "  --preset=<file.xml>     preset saved by the plugin (default: plugin defaults)\n"
+        "  --ir1=<file.wav>        overrides the preset's IR1\n"
+        "  --ir2=<file.wav>        overrides the preset's IR2\n"
+        "  --output=<folder>       where renders are written (required)\n"
+        "  --sample-rate=<hz>      render rate, inputs are resampled to it (default 48000)\n"
+        "  --block-size=<samples>  processBlock size (default 256)\n"
+        "  --jobs=<n>              worker threads (default: number of cores)\n"
+        "  --bpm=<bpm>             tempo reported to the delay (default 120)\n"
+        "  --bit-depth=<16|24|32>  output WAV bit depth (default 24)\n"
+        "  --tail=<seconds>        silence rendered after each input (default 0)\n";
+
+    struct RenderSettings
+    {
+        juce::File preset, ir1, ir2, outputFolder;
+        double sampleRate = 48000.0;
+        int blockSize = 256;
+        int numWorkers = 1;
+        double bpm = 120.0;
+        int bitDepth = 24;
+        double tailSeconds = 0.0;
+    };
+
+    struct RenderJob
+    {
+        juce::File input, output;
+        juce::String error;     // empty on success
+        bool attempted = false;
+        double seconds = 0.0;
+    };
+
+    juce::File resolveFile(const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path.unquoted());
+    }
+
+    //==============================================================================
+    // Transport for the render: always playing, fixed tempo, position follows the file
+    class RenderPlayHead : public juce::AudioPlayHead
+    {
+    public:
+        RenderPlayHead(double bpmToReport, double rate) : bpm(bpmToReport), sampleRate(rate) {}
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(bpm);
+            info.setTimeSignature(juce::AudioPlayHead::TimeSignature {});
+            info.setIsPlaying(true);
+            info.setTimeInSamples(samplePosition);
+            info.setTimeInSeconds(static_cast<double>(samplePosition) / sampleRate);
+            info.setPpqPosition(static_cast<double>(samplePosition) / sampleRate * bpm / 60.0);
+            return info;
+        }
+
+        juce::int64 samplePosition = 0;
+
+    private:
+        const double bpm, sampleRate;
+    };
+
+    //==============================================================================
+    class RenderWorker : public juce::Thread
+    {
+    public:
+        RenderWorker(int index, const RenderSettings& s, std::vector<RenderJob>& allJobs,
+                     std::atomic<size_t>& jobCounter, juce::CriticalSection& consoleLock)
+            : juce::Thread("IRFx Render " + juce::String(index)),
+              settings(s), jobs(allJobs), nextJob(jobCounter), printLock(consoleLock),
+              playHead(s.bpm, s.sampleRate)
+        {
+            formats.registerBasicFormats();
+        }
+
+        ~RenderWorker() override
+        {
+            stopThread(-1);
+        }
+
+        // Message thread: the processor's parameter tree expects to be built there
+        juce::String setUp()
+        {
+            processor = std::make_unique<IRFxAudioProcessor>();
+            processor->setNonRealtime(true);
+            processor->setPlayConfigDetails(2, 2, settings.sampleRate, settings.blockSize);
+            processor->setPlayHead(&playHead);
+
+            if (settings.preset != juce::File())
+                processor->loadPreset(settings.preset);
+
+            // Command-line IRs win over the ones stored in the preset
+            const auto stateIR = [this] (const char* property)
+            {
+                return juce::File(processor->apvts.state.getProperty(property).toString());
+            };
+
+            const auto ir1 = settings.ir1 != juce::File() ? settings.ir1 : stateIR("IR1FilePath");
+            const auto ir2 = settings.ir2 != juce::File() ? settings.ir2 : stateIR("IR2FilePath");
+
+            for (const auto& ir : { ir1, ir2 })
+                if (ir != juce::File() && ! ir.existsAsFile())
+                    return "IR not found: " + ir.getFullPathName();
+
+            // Before prepareToPlay these are only remembered, prepareToPlay starts the loads
+            if (ir1.existsAsFile())
+                processor->loadIR1(ir1);
+            if (ir2.existsAsFile())
+                processor->loadIR2(ir2);
+
+            processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+            return {};
+        }
+
+        void releaseProcessor()
+        {
+            if (processor != nullptr)
+                processor->releaseResources();
+            processor.reset();
+        }
+
+        juce::String getWarmUpError() const { return warmUpError; }
+
+    private:
+        void run() override
+        {
+            if (! waitForImpulseResponses())
+            {
+                warmUpError = "timed out waiting for the IRs to load";
+                return;
+            }
+
+            for (;;)
+            {
+                const auto index = nextJob.fetch_add(1);
+                if (index >= jobs.size() || threadShouldExit())
+                    break;
+
+                auto& job = jobs[index];
+                job.attempted = true;
+                const auto start = juce::Time::getMillisecondCounterHiRes();
+                job.error = render(job.input, job.output);
+                job.seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+
+                const juce::ScopedLock lock(printLock);
+                std::cout << (job.error.isEmpty() ? "  ok    " : "  FAIL  ") << job.input.getFullPathName()
+                          << (job.error.isEmpty() ? juce::String(" (" + juce::String(job.seconds, 2) + " s)")
+                                                  : " - " + job.error) << std::endl;
+            }
+        }
+
+        // IRs are built on the convolution's background thread and only swapped in
+        // from processBlock, so feed silence until every active slot has one.
+        bool waitForImpulseResponses()
+        {
+            // A bypassed IR stage never swaps, and is never heard either
+            const auto expects = [this] (int irIndex)
+            {
+                return processor->isIRLoaded(irIndex) && ! processor->isIRMuted(irIndex)
+                    && ! processor->snapshot.getBool(Params::irBypass) && ! processor->snapshot.getBool(Params::pluginBypass);
+            };
+            const auto ready = [this, &expects]
+            {
+                return (! expects(1) || processor->irLoader1->getCurrentIRSize() > 0)
+                    && (! expects(2) || processor->irLoader2->getCurrentIRSize() > 0)
+                    && ! processor->isRestoringIRs();
+            };
+
+            juce::AudioBuffer<float> silence(2, settings.blockSize);
+            const auto deadline = juce::Time::getMillisecondCounter() + 10000;
+
+            while (! ready())
+            {
+                if (threadShouldExit() || juce::Time::getMillisecondCounter() > deadline)
+                    return false;
+
+                processSilence(silence);
+                wait(1);
+            }
+
+            // Let the convolution's crossfade into the new IR finish
+            for (int done = 0; done < static_cast<int>(settings.sampleRate * 0.25); done += settings.blockSize)
+                processSilence(silence);
+
+            return true;
+        }
+
+        void processSilence(juce::AudioBuffer<float>& buffer)
+        {
+            buffer.clear();
+            processor->processBlock(buffer, midi);
+        }
+
+        juce::String render(const juce::File& input, const juce::File& output)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+            if (reader == nullptr)
+                return "not a readable audio file";
+
+            if (reader->lengthInSamples <= 0 || reader->lengthInSamples > std::numeric_limits<int>::max() / 2)
+                return "unsupported length";
+
+            const int numInputSamples = static_cast<int>(reader->lengthInSamples);
+            juce::AudioBuffer<float> source(2, numInputSamples);
+            reader->read(&source, 0, numInputSamples, 0, true, true);
+
+            // Mono DI: same signal on both sides, as the plugin does for a mono input bus
+            if (reader->numChannels == 1)
+                source.copyFrom(1, 0, source, 0, 0, numInputSamples);
+
+            if (reader->sampleRate != settings.sampleRate)
+                source = resample(source, reader->sampleRate);
+
+            const int numSamples = source.getNumSamples();
+            const int latency = processor->getLatencySamples();
+            const int numRendered = numSamples + static_cast<int>(settings.tailSeconds * settings.sampleRate);
+
+            juce::AudioBuffer<float> rendered(2, numRendered);
+            juce::AudioBuffer<float> block(2, settings.blockSize);
+
+            processor->reset();
+            playHead.samplePosition = 0;
+
+            // Run latency samples past the end and drop as many from the start, so the render lines up with the input
+            for (int pos = 0; pos < numRendered + latency; pos += settings.blockSize)
+            {
+                const int blockLength = juce::jmin(settings.blockSize, numRendered + latency - pos);
+                block.setSize(2, blockLength, false, false, true);
+                block.clear();
+
+                const int toCopy = juce::jlimit(0, blockLength, numSamples - pos);
+                for (int ch = 0; ch < 2; ++ch)
+                    if (toCopy > 0)
+                        block.copyFrom(ch, 0, source, ch, pos, toCopy);
+
+                processor->processBlock(block, midi);
+                playHead.samplePosition += blockLength;
+
+                const int skip = juce::jmax(0, latency - pos);
+                const int destStart = juce::jmax(0, pos - latency);
+                const int toKeep = juce::jmin(blockLength - skip, numRendered - destStart);
+                for (int ch = 0; ch < 2; ++ch)
+                    if (toKeep > 0)
+                        rendered.copyFrom(ch, destStart, block, ch, skip, toKeep);
+            }
+
+            return write(rendered, output);
+        }
+
+        juce::AudioBuffer<float> resample(const juce::AudioBuffer<float>& source, double sourceRate) const
+        {
+            const double ratio = sourceRate / settings.sampleRate;
+            const int numOut = static_cast<int>(std::ceil(source.getNumSamples() / ratio));
+
+            // The interpolator reads a little past the last sample it needs
+            const int padding = static_cast<int>(std::ceil(ratio)) + 64;
+            juce::AudioBuffer<float> padded(2, source.getNumSamples() + padding);
+            padded.clear();
+
+            juce::AudioBuffer<float> result(2, numOut);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                padded.copyFrom(ch, 0, source, ch, 0, source.getNumSamples());
+                juce::WindowedSincInterpolator interpolator;
+                interpolator.process(ratio, padded.getReadPointer(ch), result.getWritePointer(ch), numOut);
+            }
+
+            return result;
+        }
+
+        juce::String write(const juce::AudioBuffer<float>& audio, const juce::File& output)
+        {
+            if (! output.deleteFile())
+                return "cannot replace " + output.getFullPathName();
+
+            auto stream = output.createOutputStream();
+            if (stream == nullptr)
+                return "cannot write " + output.getFullPathName();
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), settings.sampleRate, 2,
+                                                                                settings.bitDepth, {}, 0));
+            if (writer == nullptr)
+                return "cannot create a WAV writer";
+
+            stream.release();   // owned by the writer now
+
+            if (! writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples()))
+                return "write failed";
+
+            return {};
+        }
+
+        const RenderSettings& settings;
+        std::vector<RenderJob>& jobs;
+        std::atomic<size_t>& nextJob;
+        juce::CriticalSection& printLock;
+
+        RenderPlayHead playHead;
+        juce::AudioFormatManager formats;
+        juce::MidiBuffer midi;
+        std::unique_ptr<IRFxAudioProcessor> processor;
+        juce::String warmUpError;
+
+        JUCE_DECLARE_NON_COPYABLE (RenderWorker)
+    };
+
+    //==============================================================================
+    juce::String parseSettings(const juce::ArgumentList& args, RenderSettings& settings)
+    {
+        const auto option = [&args] (const char* name) { return args.getValueForOption(name); };
+
+        if (option("--output").isEmpty())
+            return "--output is required";
+
+        settings.outputFolder = resolveFile(option("--output"));
+
+        if (const auto preset = option("--preset"); preset.isNotEmpty())
+        {
+            settings.preset = resolveFile(preset);
+            if (! settings.preset.existsAsFile())
+                return "preset not found: " + settings.preset.getFullPathName();
+        }
+
+        if (const auto ir1 = option("--ir1"); ir1.isNotEmpty())
+            settings.ir1 = resolveFile(ir1);
+        if (const auto ir2 = option("--ir2"); ir2.isNotEmpty())
+            settings.ir2 = resolveFile(ir2);
+
+        if (const auto rate = option("--sample-rate"); rate.isNotEmpty())
+            settings.sampleRate = rate.getDoubleValue();
+        if (const auto size = option("--block-size"); size.isNotEmpty())
+            settings.blockSize = size.getIntValue();
+        if (const auto bpm = option("--bpm"); bpm.isNotEmpty())
+            settings.bpm = bpm.getDoubleValue();
+        if (const auto depth = option("--bit-depth"); depth.isNotEmpty())
+            settings.bitDepth = depth.getIntValue();
+        if (const auto tail = option("--tail"); tail.isNotEmpty())
+            settings.tailSeconds = tail.getDoubleValue();
+
+        settings.numWorkers = juce::SystemStats::getNumCpus();
+        if (const auto jobs = option("--jobs"); jobs.isNotEmpty())
+            settings.numWorkers = jobs.getIntValue();
+
+        if (settings.sampleRate < 8000.0 || settings.sampleRate > 384000.0)
+            return "--sample-rate must be between 8000 and 384000";
+        if (settings.blockSize < 1 || settings.blockSize > 8192)
+            return "--block-size must be between 1 and 8192";
+        if (settings.bpm < 20.0 || settings.bpm > 999.0)
+            return "--bpm must be between 20 and 999";
+        if (settings.bitDepth != 16 && settings.bitDepth != 24 && settings.bitDepth != 32)
+            return "--bit-depth must be 16, 24 or 32";
+        if (settings.tailSeconds < 0.0 || settings.tailSeconds > 60.0)
+            return "--tail must be between 0 and 60 seconds";
+        if (settings.numWorkers < 1)
+            return "--jobs must be at least 1";
+
+        return {};
+    }
+
+    // Positional arguments are WAV files or folders of them (not recursive)
+    juce::String collectJobs(const juce::ArgumentList& args, const RenderSettings& settings, std::vector<RenderJob>& jobs)
+    {
+        juce::Array<juce::File> inputs;
+
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+            if (arg.isOption())
+            {
+                if (! arg.text.contains("="))
+                    ++i;    // "--option value" form
+                continue;
+            }
+
+            const auto file = arg.resolveAsFile();
+            if (file.isDirectory())
+            {
+                auto found = file.findChildFiles(juce::File::findFiles, false, "*.wav;*.WAV");
+                found.sort();
+                inputs.addArray(found);
+            }
+            else if (file.existsAsFile())
+            {
+                inputs.add(file);
+            }
+            else
+            {
+                return "input not found: " + file.getFullPathName();
+            }
+        }
+
+        juce::StringArray outputPaths;
+        for (const auto& input : inputs)
+        {
+            const auto output = settings.outputFolder.getChildFile(input.getFileNameWithoutExtension() + ".wav");
+
+            if (output == input)
+                return "refusing to overwrite the input " + input.getFullPathName();
+            if (outputPaths.contains(output.getFullPathName()))
+                return "two inputs would both render to " + output.getFullPathName();
+
+            outputPaths.add(output.getFullPathName());
+            jobs.push_back({ input, output });
+        }
+
+        return {};
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    RenderSettings settings;
+    std::vector<RenderJob> jobs;
+
+    auto error = parseSettings(args, settings);
+    if (error.isEmpty())
+        error = collectJobs(args, settings, jobs);
+    if (error.isEmpty() && jobs.empty())
+        error = "no input files";
+    if (error.isEmpty() && ! settings.outputFolder.createDirectory())
+        error = "cannot create " + settings.outputFolder.getFullPathName();
+
+    if (error.isNotEmpty())
+    {
+        std::cerr << "IRFxRender: " << error << "\n\n" << usage;
+        return 1;
+    }
+
+    const int numWorkers = juce::jmin(settings.numWorkers, static_cast<int>(jobs.size()));
+    std::cout << "Rendering " << jobs.size() << " file(s) at " << settings.sampleRate << " Hz, block "
+              << settings.blockSize << ", " << numWorkers << " worker(s)" << std::endl;
+
+    std::atomic<size_t> nextJob { 0 };
+    juce::CriticalSection consoleLock;
+    std::vector<std::unique_ptr<RenderWorker>> workers;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto worker = std::make_unique<RenderWorker>(i + 1, settings, jobs, nextJob, consoleLock);
+        if (const auto setUpError = worker->setUp(); setUpError.isNotEmpty())
+        {
+            std::cerr << "IRFxRender: " << setUpError << std::endl;
+            return 1;
+        }
+        workers.push_back(std::move(worker));
+    }
+
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto& worker : workers)
+        worker->startThread();
+
+    int failedWorkers = 0;
+    for (auto& worker : workers)
+    {
+        worker->waitForThreadToExit(-1);
+        if (const auto warmUpError = worker->getWarmUpError(); warmUpError.isNotEmpty())
+        {
+            std::cerr << "IRFxRender: " << worker->getThreadName() << ": " << warmUpError << std::endl;
+            ++failedWorkers;
+        }
+        worker->releaseProcessor();
+    }
+
+    int failed = 0, skipped = 0;
+    for (const auto& job : jobs)
+    {
+        if (job.error.isNotEmpty())
+            ++failed;
+        else if (! job.attempted)
+            ++skipped;  // never picked up because every worker failed to warm up
+    }
+
+    std::cout << "Done in " << juce::String((juce::Time::getMillisecondCounterHiRes() - start) * 0.001, 1) << " s: "
+              << (jobs.size() - static_cast<size_t>(failed + skipped)) << " rendered, " << failed << " failed";
+    if (skipped > 0)
+        std::cout << ", " << skipped << " not rendered";
+    std::cout << std::endl;
+
+    return (failed + skipped + failedWorkers) > 0 ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 8:51:19am
+    Author:  Aaron Petrini
+
+    Real-time safety check: drives IRFxAudioProcessor through a scripted
+    session (automation of every parameter, IR swaps, preset loads, module,
+    plugin and host bypass, odd block sizes) with the heap and mutexes
+    guarded on the processBlock thread. Exits nonzero on any violation.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../Common/TestSignals.h"
+#include "RealtimeGuard.h"
+
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: IRFxRTCheck [options]\n"
+        "\n"
+        "  --seconds=<n>      audio rendered per phase (default 20)\n"
+        "  --block-size=<n>   prepared block size (default 256)\n"
+        "  --sample-rate=<hz> default 48000\n"
+        "  --max-traces=<n>   stack traces printed before only counting (default 10)\n"
+        "  --abort            abort on the first violation, for running under a debugger\n";
+
+    struct Scenario
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 256;
+        int seconds = 20;
+        juce::File irA, irB, presetA, presetB;
+    };
+
+    // Presets are written by the plugin itself so they match whatever the current format is
+    void writePreset(const juce::File& file, int seed)
+    {
+        IRFxAudioProcessor processor;
+        juce::Random random(seed);
+
+        for (auto* param : processor.cachedParams)
+            if (param != processor.cachedParams[Params::pluginBypass])
+                param->setValueNotifyingHost(random.nextFloat());
+
+        processor.savePreset(file);
+    }
+
+    // Message-thread side of one block: what a host and a user would be doing meanwhile
+    void automate(IRFxAudioProcessor& processor, const Scenario& scenario, int block)
+    {
+        for (const auto& spec : Params::table)
+        {
+            auto* param = processor.cachedParams[static_cast<size_t>(spec.index)];
+
+            switch (spec.type)
+            {
+                case Params::Type::floating:
+                    param->setValueNotifyingHost(0.5f + 0.45f * std::sin(0.05f * static_cast<float>(block) + static_cast<float>(spec.index)));
+                    break;
+
+                case Params::Type::choice:
+                    if (block % 250 == 0)
+                        param->setValueNotifyingHost(param->convertTo0to1(static_cast<float>((block / 250 + spec.index) % spec.numChoices)));
+                    break;
+
+                case Params::Type::boolean:
+                    // Every bypass, including the plugin's own, flips now and then
+                    if (block % 90 == spec.index)
+                        param->setValueNotifyingHost(param->getValue() < 0.5f ? 1.f : 0.f);
+                    break;
+            }
+        }
+
+        if (block % 400 == 100)
+            processor.loadIR1((block / 400) % 2 == 0 ? scenario.irB : scenario.irA);
+        if (block % 400 == 300)
+            processor.loadIR2((block / 400) % 2 == 0 ? scenario.irA : scenario.irB);
+        if (block % 150 == 75)
+            processor.setIRMuted(1 + (block / 150) % 2, ! processor.isIRMuted(1 + (block / 150) % 2));
+        if (block % 1000 == 500)
+            processor.loadPreset((block / 1000) % 2 == 0 ? scenario.presetA : scenario.presetB);
+    }
+
+    int runPhase(const Scenario& scenario, int numInputChannels)
+    {
+        std::cout << "Phase: " << (numInputChannels == 1 ? "mono" : "stereo") << " input, "
+                  << scenario.seconds << " s at " << scenario.sampleRate << " Hz / " << scenario.blockSize << std::endl;
+
+        const auto violationsBefore = RealtimeGuard::getTotalCount();
+
+        IRFxAudioProcessor processor;
+        processor.setPlayConfigDetails(numInputChannels, 2, scenario.sampleRate, scenario.blockSize);
+        processor.tracer.setEnabled(true);
+        processor.watchdog.setThresholds({ 1.0e6f, 2.0e6f, 3.0e6f });   // exercised, but never logs from a test
+        processor.loadIR1(scenario.irA);
+        processor.loadIR2(scenario.irB);
+        processor.prepareToPlay(scenario.sampleRate, scenario.blockSize);
+
+        // The host's buffer: as many channels as the wider bus, sized for the biggest block we send
+        juce::AudioBuffer<float> buffer(2, scenario.blockSize * 2);
+        juce::MidiBuffer midi;
+        juce::Random random(numInputChannels);
+
+        const int numBlocks = static_cast<int>(scenario.seconds * scenario.sampleRate) / scenario.blockSize;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            automate(processor, scenario, block);
+            processor.commitPendingPreset();    // no message loop to run the preset switch timer
+
+            // Mostly the prepared size, sometimes a short one, now and then a host going over
+            int numSamples = scenario.blockSize;
+            if (block % 97 == 0)
+                numSamples = scenario.blockSize * 2;
+            else if (block % 13 == 0)
+                numSamples = random.nextInt({ 1, scenario.blockSize });
+
+            buffer.setSize(2, numSamples, false, false, true);
+            buffer.clear();
+            for (int ch = 0; ch < numInputChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * 0.3f);
+
+            const bool hostBypassed = block % 700 >= 600 && block % 700 < 620;
+
+            {
+                RealtimeGuard::ScopedRealtimeSection realtime;
+
+                if (hostBypassed)
+                    processor.processBlockBypassed(buffer, midi);
+                else
+                    processor.processBlock(buffer, midi);
+            }
+
+            // Gives the convolution loader threads time to finish, so swaps really happen mid-run
+            if (block % 4 == 0)
+                juce::Thread::sleep(1);
+        }
+
+        processor.releaseResources();
+
+        const auto violations = RealtimeGuard::getTotalCount() - violationsBefore;
+        std::cout << "  " << numBlocks << " blocks, " << violations << " violation(s)" << std::endl;
+        return static_cast<int>(violations);
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    if (! RealtimeGuard::isSupported())
+    {
+        std::cerr << "IRFxRTCheck: the allocation and lock hooks are only implemented for Linux (glibc)" << std::endl;
+        return 2;
+    }
+
+    const auto option = [&args] (const char* name, int fallback)
+    {
+        const auto value = args.getValueForOption(name);
+        return value.isNotEmpty() ? value.getIntValue() : fallback;
+    };
+
+    RealtimeGuard::initialise(args.containsOption("--abort"), option("--max-traces", 10));
+
+    Scenario scenario;
+    scenario.seconds = option("--seconds", scenario.seconds);
+    scenario.blockSize = option("--block-size", scenario.blockSize);
+    scenario.sampleRate = option("--sample-rate", static_cast<int>(scenario.sampleRate));
+
+    if (scenario.seconds < 1 || scenario.blockSize < 16 || scenario.blockSize > 8192 || scenario.sampleRate < 8000.0)
+    {
+        std::cerr << "IRFxRTCheck: invalid options\n\n" << usage;
+        return 1;
+    }
+
+    const auto tempFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("IRFxRTCheck-" + juce::String(juce::Time::currentTimeMillis()));
+    scenario.irA = tempFolder.getChildFile("cabA.wav");
+    scenario.irB = tempFolder.getChildFile("cabB.wav");
+    scenario.presetA = tempFolder.getChildFile("presetA.xml");
+    scenario.presetB = tempFolder.getChildFile("presetB.xml");
+
+    if (! tempFolder.createDirectory() || ! TestSignals::writeImpulseResponse(scenario.irA, 0.05, 1) || ! TestSignals::writeImpulseResponse(scenario.irB, 0.3, 2))
+    {
+        std::cerr << "IRFxRTCheck: cannot write test files to " << tempFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    writePreset(scenario.presetA, 1);
+    writePreset(scenario.presetB, 2);
+
+    int violations = runPhase(scenario, 2);
+    violations += runPhase(scenario, 1);
+
+    tempFolder.deleteRecursively();
+
+    std::cout << "\n";
+    for (int v = 0; v < RealtimeGuard::numViolations; ++v)
+    {
+        const auto violation = static_cast<RealtimeGuard::Violation>(v);
+        std::cout << RealtimeGuard::getViolationName(violation) << ": " << RealtimeGuard::getCount(violation) << "\n";
+    }
+
+    std::cout << (violations == 0 ? "PASS" : "FAIL") << std::endl;
+    return violations == 0 ? 0 : 1;
+}
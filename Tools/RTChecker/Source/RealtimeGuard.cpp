@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 19 Oct 2026 8:51:19am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#if JUCE_LINUX
+ #include <cerrno>
+ #include <cstdio>
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <pthread.h>
+ #include <unistd.h>
+#endif
+
+namespace RealtimeGuard
+{
+    namespace
+    {
+        // Plain thread_locals: no constructor, so reading them from inside malloc can't recurse
+        thread_local int sectionDepth = 0;
+        thread_local bool isReporting = false;
+
+        std::array<std::atomic<uint64_t>, numViolations> counts {};
+        std::atomic<int> tracesLeft { 10 };
+        std::atomic<bool> shouldAbort { false };
+    }
+
+    const char* getViolationName(Violation violation)
+    {
+        switch (violation)
+        {
+            case allocation:    return "allocation";
+            case deallocation:  return "deallocation";
+            case mutexLock:     return "mutex lock";
+            case numViolations: break;
+        }
+        return "";
+    }
+
+    uint64_t getCount(Violation violation)  { return counts[static_cast<size_t>(violation)].load(); }
+
+    uint64_t getTotalCount()
+    {
+        uint64_t total = 0;
+        for (auto& count : counts)
+            total += count.load();
+        return total;
+    }
+
+    ScopedRealtimeSection::ScopedRealtimeSection()  { ++sectionDepth; }
+    ScopedRealtimeSection::~ScopedRealtimeSection() { --sectionDepth; }
+
+   #if JUCE_LINUX
+    bool isSupported() { return true; }
+
+    void initialise(bool abortOnViolation, int maxReportedTraces)
+    {
+        shouldAbort = abortOnViolation;
+        tracesLeft = maxReportedTraces;
+
+        void* frames[4];
+        backtrace(frames, 4);
+
+        // Resolves the real pthread_mutex_lock
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_mutex_lock(&mutex);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    // Called from the interposed functions below. Everything in here must work without the heap.
+    static void report(Violation violation, size_t bytes)
+    {
+        if (sectionDepth == 0 || isReporting)
+            return;
+
+        isReporting = true;
+        counts[static_cast<size_t>(violation)].fetch_add(1);
+
+        if (tracesLeft.fetch_sub(1) > 0)
+        {
+            char line[160];
+            const int length = std::snprintf(line, sizeof(line), "\n*** real-time violation on the audio thread: %s%s",
+                                             getViolationName(violation), bytes > 0 ? "" : "\n");
+            [[maybe_unused]] auto written = ::write(STDERR_FILENO, line, static_cast<size_t>(juce::jmax(0, length)));
+
+            if (bytes > 0)
+            {
+                const int sizeLength = std::snprintf(line, sizeof(line), " of %zu bytes\n", bytes);
+                written = ::write(STDERR_FILENO, line, static_cast<size_t>(juce::jmax(0, sizeLength)));
+            }
+
+            void* frames[64];
+            const int numFrames = backtrace(frames, 64);
+            // Skip report() and the interposed function itself
+            backtrace_symbols_fd(frames + 2, juce::jmax(0, numFrames - 2), STDERR_FILENO);
+        }
+
+        if (shouldAbort.load())
+            std::abort();
+
+        isReporting = false;
+    }
+   #else
+    bool isSupported() { return false; }
+    void initialise(bool, int) {}
+   #endif
+}
+
+#if JUCE_LINUX
+//==============================================================================
+// glibc's own allocator entry points, so the replacements below never go through dlsym
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, size);
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        RealtimeGuard::report(RealtimeGuard::allocation, size);
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* pointer)
+    {
+        if (pointer != nullptr)
+            RealtimeGuard::report(RealtimeGuard::deallocation, 0);
+        __libc_free(pointer);
+    }
+
+    // The real lock has no public alias, so it is looked up once, on first use (never from a real-time section in practice)
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        using LockFunction = int (*)(pthread_mutex_t*);
+        static std::atomic<LockFunction> realLock { nullptr };
+
+        auto lock = realLock.load(std::memory_order_acquire);
+        if (lock == nullptr)
+        {
+            lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            realLock.store(lock, std::memory_order_release);
+        }
+
+        RealtimeGuard::report(RealtimeGuard::mutexLock, 0);
+        return lock(mutex);
+    }
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 19 Oct 2026 8:51:19am
+    Author:  Aaron Petrini
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Catches heap and mutex use on a thread that promised not to (Linux/glibc only).
+ *
+ * malloc, free and friends and pthread_mutex_lock are interposed for the whole
+ * process, so operator new/delete, std::vector, juce::HeapBlock, CriticalSection
+ * and std::mutex are all covered. Calls are only reported while the calling
+ * thread is inside a ScopedRealtimeSection; every other thread runs untouched.
+ */
+namespace RealtimeGuard
+{
+    enum Violation
+    {
+        allocation = 0,
+        deallocation,
+        mutexLock,
+        numViolations
+    };
+
+    bool isSupported();
+
+    // Call from main before arming anything: primes backtrace(), which allocates on first use
+    void initialise(bool abortOnViolation, int maxReportedTraces);
+
+    uint64_t getCount(Violation violation);
+    uint64_t getTotalCount();
+    const char* getViolationName(Violation violation);
+
+    // Marks the current thread as real-time for its lifetime. Nests.
+    struct ScopedRealtimeSection
+    {
+        ScopedRealtimeSection();
+        ~ScopedRealtimeSection();
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeSection)
+    };
+}
@@ -0,0 +1,11 @@
+#!/bin/sh
+# Builds and runs the real-time safety check. Linux only; exits nonzero on any violation.
+#   PROJUCER=/path/to/Projucer Tools/RTChecker/run-rtcheck.sh [IRFxRTCheck options]
+set -e
+
+here="$(cd "$(dirname "$0")" && pwd)"
+projucer="${PROJUCER:-Projucer}"
+
+"$projucer" --resave "$here/IRFxRTCheck.jucer"
+make -C "$here/Builds/LinuxMakefile" CONFIG=Debug -j"$(nproc)"
+"$here/Builds/LinuxMakefile/build/IRFxRTCheck" "$@"
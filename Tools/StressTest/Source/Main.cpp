@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 8:53:09am
+    Author:  Aaron Petrini
+
+    Randomised stress driver: block sizes from 1 to well over the prepared
+    maximum, sample-rate changes, every parameter automated at once, IR
+    load/unload/mute and preset switches, all from one seed. Reports the
+    worst and p99.9 block times and any NaN, Inf or denormal output.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../Common/TestSignals.h"
+
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: IRFxStress [options]\n"
+        "\n"
+        "  --iterations=<n>    bursts of blocks, each with its own random events (default 2000)\n"
+        "  --seed=<n>          same seed, same run (default: random, printed at the start)\n"
+        "  --report=<file>     also write the summary and worst blocks as JSON\n"
+        "  --fail-above=<x>    exit nonzero if any block used more than x times its real-time budget\n";
+
+    constexpr std::array<double, 6> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    constexpr std::array<int, 7> maxBlockSizes { 32, 64, 128, 256, 512, 1024, 2048 };
+    constexpr int blocksPerIteration = 32;
+    constexpr int numWorstBlocks = 10;
+
+    // Enough to reproduce one block by hand
+    struct BlockRecord
+    {
+        int iteration = 0, block = 0;
+        double sampleRate = 0.0;
+        int maxBlockSize = 0, numSamples = 0;
+        double micros = 0.0, load = 0.0;
+        juce::String lastEvent;
+    };
+
+    struct OutputFaults
+    {
+        uint64_t nonFinite = 0, denormal = 0;
+        BlockRecord firstNonFinite, firstDenormal;
+    };
+
+    struct IRSet
+    {
+        juce::Array<juce::File> files;
+        juce::StringArray descriptions;
+    };
+
+    // Deliberately awkward IRs: a single sample, mono, long, and one not at 48k
+    IRSet writeImpulseResponses(const juce::File& folder)
+    {
+        struct Spec { const char* name; double seconds; int channels; double rate; };
+        const Spec specs[] {
+            { "single-sample", 1.0 / 48000.0, 2, 48000.0 },
+            { "short-mono",    0.02,          1, 48000.0 },
+            { "cab",           0.2,           2, 48000.0 },
+            { "long",          2.0,           2, 48000.0 },
+            { "cab-96k",       0.2,           2, 96000.0 },
+        };
+
+        IRSet set;
+        int seed = 1;
+        for (const auto& spec : specs)
+        {
+            const auto file = folder.getChildFile(juce::String(spec.name) + ".wav");
+            if (TestSignals::writeImpulseResponse(file, spec.seconds, seed++, spec.channels, spec.rate))
+            {
+                set.files.add(file);
+                set.descriptions.add(spec.name);
+            }
+        }
+        return set;
+    }
+
+    void writePresets(const juce::File& folder, juce::Random& random, juce::Array<juce::File>& presets)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            IRFxAudioProcessor processor;
+            for (auto* param : processor.cachedParams)
+                param->setValueNotifyingHost(random.nextFloat());
+
+            const auto file = folder.getChildFile("preset" + juce::String(i) + ".xml");
+            processor.savePreset(file);
+            presets.add(file);
+        }
+    }
+
+    // Mostly in range, often at an extreme, which is where curves and filters misbehave
+    float randomNormalisedValue(juce::Random& random)
+    {
+        const float r = random.nextFloat();
+        if (r < 0.1f) return 0.f;
+        if (r < 0.2f) return 1.f;
+        return random.nextFloat();
+    }
+
+    int randomBlockSize(juce::Random& random, int maxBlockSize)
+    {
+        const float r = random.nextFloat();
+        if (r < 0.05f) return 1;
+        if (r < 0.10f) return maxBlockSize + 1 + random.nextInt(maxBlockSize * 3);
+        if (r < 0.40f) return maxBlockSize;
+        return 1 + random.nextInt(maxBlockSize);
+    }
+
+    void scanOutput(const juce::AudioBuffer<float>& buffer, const BlockRecord& record, OutputFaults& faults)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto* samples = buffer.getReadPointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const int kind = std::fpclassify(samples[i]);
+                if (kind == FP_NAN || kind == FP_INFINITE)
+                {
+                    if (faults.nonFinite++ == 0)
+                        faults.firstNonFinite = record;
+                }
+                else if (kind == FP_SUBNORMAL)
+                {
+                    if (faults.denormal++ == 0)
+                        faults.firstDenormal = record;
+                }
+            }
+        }
+    }
+
+    juce::var toVar(const BlockRecord& record)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("iteration", record.iteration);
+        object->setProperty("block", record.block);
+        object->setProperty("sampleRate", record.sampleRate);
+        object->setProperty("maxBlockSize", record.maxBlockSize);
+        object->setProperty("numSamples", record.numSamples);
+        object->setProperty("micros", record.micros);
+        object->setProperty("load", record.load);
+        object->setProperty("lastEvent", record.lastEvent);
+        return juce::var(object);
+    }
+
+    juce::String describe(const BlockRecord& record)
+    {
+        return "iteration " + juce::String(record.iteration) + " block " + juce::String(record.block)
+             + ", " + juce::String(record.numSamples) + " samples (max " + juce::String(record.maxBlockSize)
+             + ") at " + juce::String(record.sampleRate, 0) + " Hz: " + juce::String(record.micros, 1) + " us, load "
+             + juce::String(record.load, 3) + ", after " + record.lastEvent;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    const auto iterationsOption = args.getValueForOption("--iterations");
+    const int iterations = iterationsOption.isNotEmpty() ? iterationsOption.getIntValue() : 2000;
+    const auto seedOption = args.getValueForOption("--seed");
+    const auto seed = seedOption.isNotEmpty() ? seedOption.getLargeIntValue() : juce::Random::getSystemRandom().nextInt64();
+    const auto failAboveOption = args.getValueForOption("--fail-above");
+    const double failAbove = failAboveOption.isNotEmpty() ? failAboveOption.getDoubleValue() : 0.0;
+
+    if (iterations < 1)
+    {
+        std::cerr << "IRFxStress: --iterations must be at least 1\n\n" << usage;
+        return 1;
+    }
+
+    std::cout << "IRFxStress: " << iterations << " iterations, seed " << seed << std::endl;
+    juce::Random random(seed);
+
+    const auto tempFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("IRFxStress-" + juce::String(juce::Time::currentTimeMillis()));
+    if (! tempFolder.createDirectory())
+    {
+        std::cerr << "IRFxStress: cannot create " << tempFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    const auto irs = writeImpulseResponses(tempFolder);
+    juce::Array<juce::File> presets;
+    writePresets(tempFolder, random, presets);
+
+    IRFxAudioProcessor processor;
+    // Keep the watchdog in the loop, but its logs are for real sessions
+    processor.watchdog.setThresholds({ 1.0e6f, 2.0e6f, 3.0e6f });
+
+    double sampleRate = 48000.0;
+    int maxBlockSize = 256;
+    const auto prepare = [&]
+    {
+        processor.releaseResources();
+        processor.setPlayConfigDetails(2, 2, sampleRate, maxBlockSize);
+        processor.prepareToPlay(sampleRate, maxBlockSize);
+    };
+    prepare();
+
+    juce::AudioBuffer<float> buffer(2, maxBlockSizes.back() * 4);
+    juce::MidiBuffer midi;
+
+    std::vector<float> loads;
+    loads.reserve(static_cast<size_t>(iterations * blocksPerIteration));
+    std::vector<BlockRecord> worst;
+    OutputFaults faults;
+    juce::String lastEvent = "start";
+
+    const auto event = [&lastEvent] (juce::String description) { lastEvent = std::move(description); };
+
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        // A host changing its audio settings, with processing stopped as it must be
+        if (iteration > 0 && random.nextFloat() < 0.05f)
+        {
+            sampleRate = sampleRates[static_cast<size_t>(random.nextInt(static_cast<int>(sampleRates.size())))];
+            maxBlockSize = maxBlockSizes[static_cast<size_t>(random.nextInt(static_cast<int>(maxBlockSizes.size())))];
+            prepare();
+            event("prepareToPlay " + juce::String(sampleRate, 0) + " / " + juce::String(maxBlockSize));
+        }
+
+        for (int block = 0; block < blocksPerIteration; ++block)
+        {
+            // No message loop here, so preset switches commit from the loop once their IRs are in
+            processor.commitPendingPreset();
+
+            // Message-thread side: every parameter moves, some jump to the ends of their range
+            for (auto* param : processor.cachedParams)
+                if (param != processor.cachedParams[Params::pluginBypass] || random.nextFloat() < 0.02f)
+                    if (random.nextFloat() < 0.5f)
+                        param->setValueNotifyingHost(randomNormalisedValue(random));
+
+            const float r = random.nextFloat();
+            const int slot = 1 + random.nextInt(2);
+
+            if (r < 0.02f && ! irs.files.isEmpty())
+            {
+                const int index = random.nextInt(irs.files.size());
+                slot == 1 ? processor.loadIR1(irs.files[index]) : processor.loadIR2(irs.files[index]);
+                event("load " + irs.descriptions[index] + " into IR" + juce::String(slot));
+            }
+            else if (r < 0.03f)
+            {
+                processor.unloadIR(slot);
+                event("unload IR" + juce::String(slot));
+            }
+            else if (r < 0.05f)
+            {
+                processor.setIRMuted(slot, ! processor.isIRMuted(slot));
+                event("toggle mute IR" + juce::String(slot));
+            }
+            else if (r < 0.06f && ! presets.isEmpty())
+            {
+                const int index = random.nextInt(presets.size());
+                processor.loadPreset(presets[index]);
+                event("preset " + presets[index].getFileNameWithoutExtension());
+            }
+
+            BlockRecord record { iteration, block, sampleRate, maxBlockSize, randomBlockSize(random, maxBlockSize), 0.0, 0.0, lastEvent };
+
+            buffer.setSize(2, record.numSamples, false, false, true);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < record.numSamples; ++i)
+                    buffer.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * 0.5f);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+            record.micros = juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e6;
+            record.load = record.micros * 1.0e-6 * sampleRate / record.numSamples;
+            loads.push_back(static_cast<float>(record.load));
+
+            scanOutput(buffer, record, faults);
+
+            // Worst by load: a 1-sample block is supposed to be cheap in absolute terms
+            if (worst.size() < numWorstBlocks || record.load > worst.back().load)
+            {
+                worst.push_back(record);
+                std::sort(worst.begin(), worst.end(), [] (const auto& a, const auto& b) { return a.load > b.load; });
+                if (worst.size() > numWorstBlocks)
+                    worst.pop_back();
+            }
+        }
+
+        // IR loads finish on background threads; let them land between bursts
+        juce::Thread::sleep(1);
+
+        if ((iteration + 1) % 500 == 0)
+            std::cout << "  " << (iteration + 1) << " iterations" << std::endl;
+    }
+
+    processor.releaseResources();
+    tempFolder.deleteRecursively();
+
+    const auto percentile = [&loads] (double fraction)
+    {
+        auto sorted = loads;
+        const auto index = static_cast<size_t>(juce::jlimit(0.0, static_cast<double>(sorted.size() - 1), std::ceil(fraction * static_cast<double>(sorted.size())) - 1.0));
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+        return static_cast<double>(sorted[index]);
+    };
+
+    const double p99 = percentile(0.99), p999 = percentile(0.999);
+
+    std::cout << "\nBlocks: " << loads.size() << "\n"
+              << "Load (fraction of the real-time budget): p99 " << juce::String(p99, 3)
+              << ", p99.9 " << juce::String(p999, 3) << ", worst " << juce::String(worst.front().load, 3) << "\n"
+              << "Non-finite samples: " << faults.nonFinite << "\n"
+              << "Denormal samples: " << faults.denormal << "\n\nWorst blocks:\n";
+
+    for (const auto& record : worst)
+        std::cout << "  " << describe(record) << "\n";
+
+    if (faults.nonFinite > 0)
+        std::cout << "\nFirst non-finite output: " << describe(faults.firstNonFinite) << "\n";
+    if (faults.denormal > 0)
+        std::cout << "First denormal output: " << describe(faults.firstDenormal) << "\n";
+
+    if (const auto reportOption = args.getValueForOption("--report"); reportOption.isNotEmpty())
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("seed", seed);
+        root->setProperty("iterations", iterations);
+        root->setProperty("blocks", static_cast<juce::int64>(loads.size()));
+        root->setProperty("p99Load", p99);
+        root->setProperty("p999Load", p999);
+        root->setProperty("nonFiniteSamples", static_cast<juce::int64>(faults.nonFinite));
+        root->setProperty("denormalSamples", static_cast<juce::int64>(faults.denormal));
+
+        juce::Array<juce::var> worstList;
+        for (const auto& record : worst)
+            worstList.add(toVar(record));
+        root->setProperty("worstBlocks", worstList);
+
+        if (faults.nonFinite > 0)
+            root->setProperty("firstNonFinite", toVar(faults.firstNonFinite));
+
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(reportOption);
+        if (! file.replaceWithText(juce::JSON::toString(juce::var(root))))
+            std::cerr << "IRFxStress: cannot write " << file.getFullPathName() << std::endl;
+    }
+
+    const bool failed = faults.nonFinite > 0 || (failAbove > 0.0 && worst.front().load > failAbove);
+    std::cout << "\n" << (failed ? "FAIL" : "PASS") << " (seed " << seed << ")" << std::endl;
+    return failed ? 1 : 0;
+}